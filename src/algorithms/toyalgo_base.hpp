@@ -10,6 +10,7 @@
 #include"toy_std.hpp"
 #include"toytype_traits.hpp"
 #include"toyiterator.hpp"
+#include<cstring>
 
 namespace toy_std
 {
@@ -138,7 +139,7 @@ namespace toy_std
     template<typename InputIterator, typename OutputIterator>
     inline OutputIterator copy(InputIterator first, InputIterator last, OutputIterator result)
     {
-        return __copy_dispatch<InputIterator, OutputIterator>::operator()(first, last, result);
+        return __copy_dispatch<InputIterator, OutputIterator>()(first, last, result);
     }
 
     /* Complete Specialization versions of copy: Use memmove() */
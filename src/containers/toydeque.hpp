@@ -1,17 +1,47 @@
 /*
     Project:        Toy_Deque
-    Update date:    2020/1/20
+    Update date:    2026/10/17
     Author:         Zhuofan Zhang
+
+    Update Log:     2026/10/17 -- Finish tdeque: fix the iterator and map bookkeeping, free
+                                  buffers on pop, add emplace/insert/erase/clear/assign.
+                    2026/10/17 -- Keep a few emptied buffers as spares(set_buffer_cache_depth),
+                                  so FIFO traffic stops hitting the allocator.
+
+    Model(see 'The Annotated STL sources', 4.4):
+
+        __map:  | . | . | * | * | * | . | . |
+                          |   |   |
+                          v   v   v
+                     buffer buffer buffer   (buffer_size() elements each)
+                       ^                ^
+                  __start.__cur    __finish.__cur
+
+        Only the buffers in [__start.__node, __finish.__node] are allocated;
+        __finish.__cur always points at a free slot of an allocated buffer.
+        A buffer emptied by pops goes to a small per-deque spare cache
+        (up to buffer_cache_depth() of them) and is handed out again by the
+        next push that needs one; beyond that depth it goes back to the
+        allocator. A queue(push_back/pop_front) retires a buffer at the front
+        just as it needs a new one at the back, so in steady state it does
+        no allocation at all.
 */
 #pragma once
 #include"toy_std.hpp"
 #include"toymemory.hpp"
 #include"toyiterator.hpp"
 #include"toyalgo_base.hpp"
+#include<iterator>
+
+using std::initializer_list;
 
 namespace toy_std
 {
-    inline size_t 
+    // Spare buffers a deque may keep: default and upper bound of set_buffer_cache_depth().
+    const size_t __DEQUE_CACHE_DEPTH = 2;
+    const size_t __DEQUE_CACHE_MAX = 8;
+
+    inline size_t
     __deque_buf_size(size_t n, size_t sz)
     {
         // Decide the size of the buffer
@@ -27,39 +57,41 @@ namespace toy_std
     class __Deque_Iterator
     {
     public:
-        using __Self = __Deque_Iterator<BuffSize, T, T*, T&>;
+        using __Self = __Deque_Iterator<BuffSize, T, Pointer, Reference>;
+        using iterator = __Deque_Iterator<BuffSize, T, T*, T&>;
         using iterator_category = random_access_iterator_tag;
         using value_type = T;
-        using pointer = T*;
-        using reference = T&;
-        using difference_type = ptrdiff_t;
+        using pointer = Pointer;
+        using reference = Reference;
+        using difference_type = Distance;
         using map_pointer = T**;
 
         static size_t buffer_size()
         { return __deque_buf_size(BuffSize, sizeof(T)); }
 
         /* Constructors */
-        __Deque_Iterator() = default;
-        
-        __Deque_Iterator(__Self& x) :
+        __Deque_Iterator() : __cur(nullptr), __first(nullptr), __last(nullptr), __node(nullptr) { }
+
+        // iterator -> const_iterator; for iterator itself this is the copy
+        // constructor, so the copy assignment is declared alongside it.
+        __Deque_Iterator(const iterator& x) :
         __cur(x.__cur), __first(x.__first), __last(x.__last), __node(x.__node)
         { }
+        __Deque_Iterator& operator=(const __Deque_Iterator&) = default;
 
-        __Deque_Iterator(value_type* cur, value_type* first, value_type* last, map_pointer node):
-        __cur(cur), __first(first), __last(last), __node(node)
+        __Deque_Iterator(T* cur, map_pointer node) :
+        __cur(cur), __first(*node), __last(*node + buffer_size()), __node(node)
         { }
 
-        ~__Deque_Iterator() = default;
-
         /* Operators */
-        reference operator*() { return *__cur; }
+        reference operator*() const { return *__cur; }
 
-        pointer operator->() { return &(operator*()); }
+        pointer operator->() const { return &(operator*()); }
 
         __Self& operator++()
         {
             ++__cur;
-            if (__cur == last)
+            if (__cur == __last)
             {
                 set_node(__node + 1);
                 __cur = __first;
@@ -82,7 +114,7 @@ namespace toy_std
                 __cur = __last;
             }
             __cur--;
-            
+
             return *this;
         }
 
@@ -95,8 +127,8 @@ namespace toy_std
 
         __Self& operator+=(difference_type n)
         {
-            difference_type offset = n + __cur - __first;
-            if (offset > 0 && offset < difference_type(buffer_size()))
+            difference_type offset = n + (__cur - __first);
+            if (offset >= 0 && offset < difference_type(buffer_size()))
                 __cur += n;
             else
             {
@@ -105,7 +137,7 @@ namespace toy_std
                                 offset / difference_type(buffer_size()) :
                                 -difference_type((-offset - 1) / buffer_size()) - 1;
                 set_node(__node + node_offset);
-                __cur = first + (offset - node_offset * difference_type(buffer_size()));
+                __cur = __first + (offset - node_offset * difference_type(buffer_size()));
             }
 
             return *this;
@@ -133,7 +165,7 @@ namespace toy_std
                    + (__cur - __first) + (x.__last - x.__cur);
         }
 
-        reference operator[](difference_type n) { return *(*this + n); }
+        reference operator[](difference_type n) const { return *(*this + n); }
 
         bool operator==(const __Self& x) const { return __cur == x.__cur; }
         bool operator!=(const __Self& x) const { return !(*this == x); }
@@ -141,31 +173,40 @@ namespace toy_std
         {
             return (__node == x.__node) ? (__cur < x.__cur) : (__node < x.__node);
         }
+        bool operator>(const __Self& x) const { return x < *this; }
+        bool operator<=(const __Self& x) const { return !(x < *this); }
+        bool operator>=(const __Self& x) const { return !(*this < x); }
 
+        // Jump to another buffer; '__cur' is left to the caller.
         void set_node(map_pointer new_node)
         {
             __node = new_node;
-            first = *new_node;
-            last = first + difference_type(buffer_size());
+            __first = *new_node;
+            __last = __first + difference_type(buffer_size());
         }
 
-    private:
-
-        value_type* __cur;      // Currrent element in this buffer
-        value_type* __first;    // First element in this buffer
-        value_type* __last;     // Last element in this buffer 
+        T* __cur;               // Current element in this buffer
+        T* __first;             // First element in this buffer
+        T* __last;              // The end of this buffer
         map_pointer __node;     // (Line) pointer to the buffer
-        
     };
 
+    template<size_t BuffSize, typename T, typename Pointer, typename Reference>
+    inline __Deque_Iterator<BuffSize, T, Pointer, Reference>
+    operator+(ptrdiff_t n, const __Deque_Iterator<BuffSize, T, Pointer, Reference>& x)
+    {
+        return x + n;
+    }
+
     template<typename T,
-             size_t BuffSize = 0>
+             size_t BuffSize = 0,
+             typename Allocator = tallocator<T>>
     class tdeque
     {
     public:
         /* Member types */
         using value_type = T;
-        using allocator_type = tallocator<T>;
+        using allocator_type = Allocator;
         using size_type = size_t;
         using difference_type = std::ptrdiff_t;
         using reference = value_type&;
@@ -173,240 +214,753 @@ namespace toy_std
         using pointer = value_type*;
         using const_pointer = const value_type*;
         using iterator = __Deque_Iterator<BuffSize, T>;
-        using const_iterator = const __Deque_Iterator<BuffSize, T>;
+        using const_iterator = __Deque_Iterator<BuffSize, T, const T*, const T&>;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
         /* Constructors */
-        tdeque(): __start(), __finish(), __map(), __map_size(), __size(0)
+        tdeque(): __start(), __finish(), __map(), __map_size(0)
         { __create_map_and_nodes(0); }
-        inline tdeque(size_type, const value_type&);
-        tdeque(const tdeque<T, BuffSize>&);
-        tdeque(tdeque<T, BuffSize>&&);
+        explicit tdeque(const Allocator& alloc):
+        __start(), __finish(), __map(), __map_size(0),
+        __data_allocator(alloc), __map_allocator(alloc)
+        { __create_map_and_nodes(0); }
+        tdeque(size_type, const value_type&, const Allocator& = Allocator());
+        explicit tdeque(size_type count, const Allocator& alloc = Allocator()) :
+        tdeque(count, value_type(), alloc)
+        { }
+        template<typename InputIt>
+        tdeque(InputIt first, InputIt last, const Allocator& alloc = Allocator()) :
+        tdeque(alloc)
+        {
+            insert(end(), first, last);
+        }
+        tdeque(initializer_list<value_type> ilist, const Allocator& alloc = Allocator()) :
+        tdeque(ilist.begin(), ilist.end(), alloc)
+        { }
+        tdeque(const tdeque<T, BuffSize, Allocator>&);
+        // Not noexcept: the moved-from deque gets a fresh(empty) map.
+        tdeque(tdeque<T, BuffSize, Allocator>&&);
+
+        tdeque<T, BuffSize, Allocator>& operator=(const tdeque<T, BuffSize, Allocator>&);
+        tdeque<T, BuffSize, Allocator>& operator=(tdeque<T, BuffSize, Allocator>&&);
+
+        /* Destructor */
+        ~tdeque() noexcept
+        {
+            clear();
+            __deallocate_buffer(*__start.__node);
+            __release_buffer_cache(0);
+            __map_allocator.deallocate(__map, __map_size);
+        }
+
+        template<typename InputIt>
+        void assign(InputIt first, InputIt last)
+        {
+            using is_int_type = typename __Is_Integral_type_traits<InputIt>::is_int;
+            __assign_dispatch(first, last, is_int_type());
+        }
+        void assign(size_type count, const value_type& value)
+        {
+            iterator cur = __start;
+            for (; cur != __finish && count > 0; ++cur, --count)
+                *cur = value;
+            if (count == 0)
+                erase(cur, __finish);
+            else
+                insert(__finish, count, value);
+        }
+        void assign(initializer_list<value_type> ilist) { assign(ilist.begin(), ilist.end()); }
+
+        allocator_type get_allocator() const { return __data_allocator; }
 
         /* Iterators */
-        const_iterator cbegin() const noexcept { return const __start; }
-        const_iterator cend() const noexcept { return const __finish; }
+        const_iterator cbegin() const noexcept { return __start; }
+        const_iterator cend() const noexcept { return __finish; }
+        const_iterator begin() const noexcept { return __start; }
+        const_iterator end() const noexcept { return __finish; }
         iterator begin() noexcept { return __start; }
         iterator end() noexcept { return __finish; }
 
+        reverse_iterator rbegin() noexcept { return reverse_iterator(__finish); }
+        reverse_iterator rend() noexcept { return reverse_iterator(__start); }
+        const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(cend()); }
+        const_reverse_iterator crend() const noexcept { return const_reverse_iterator(cbegin()); }
+
         /* Element Access */
         reference front() { return *__start; }
+        const_reference front() const { return *__start; }
         reference back() { return *(__finish - 1); }
-        const_reference operator[](size_type pos) const { return *(__start + pos); }
-        reference operator[](size_type pos) { return const_cast<reference>(static_cast<const_reference>(*this)[pos]); }
+        const_reference back() const { return *(__finish - 1); }
+        const_reference operator[](size_type pos) const { return __start[difference_type(pos)]; }
+        reference operator[](size_type pos) { return __start[difference_type(pos)]; }
+        const_reference at(size_type pos) const
+        {
+            if (pos >= size())
+                throw std::range_error("RANGE_ERROR: the index must in range [0,size()).");
+            return (*this)[pos];
+        }
+        reference at(size_type pos)
+        {
+            return const_cast<reference>(static_cast<const tdeque<T, BuffSize, Allocator>&>(*this).at(pos));
+        }
 
         /* Capacity */
-        inline size_type size() const { return __size; }
-        inline bool empty() const { return __size == 0; }
+        inline size_type size() const { return size_type(__finish - __start); }
+        inline bool empty() const { return __finish == __start; }
+        size_type max_size() const { return __data_allocator.max_size(); }
+        // Gives the spare buffers back.
+        void shrink_to_fit() noexcept { __release_buffer_cache(0); }
+
+        /* Buffer cache */
+        size_type buffer_cache_depth() const noexcept { return __spare_depth; }
+        size_type buffer_cache_size() const noexcept { return __spare_count; }
+        // 0 turns the cache off; clamped to __DEQUE_CACHE_MAX.
+        void set_buffer_cache_depth(size_type depth) noexcept
+        {
+            __spare_depth = depth < __DEQUE_CACHE_MAX ? depth : __DEQUE_CACHE_MAX;
+            __release_buffer_cache(__spare_depth);
+        }
 
         /* Modifiers */
-        void push_back(value_type&&);
-        void push_front(value_type&&);
+        void clear() noexcept;
+
+        void push_back(const value_type& value) { emplace_back(value); }
+        void push_back(value_type&& value) { emplace_back(std::move(value)); }
+        void push_front(const value_type& value) { emplace_front(value); }
+        void push_front(value_type&& value) { emplace_front(std::move(value)); }
+        template<typename... Args>
+        reference emplace_back(Args&&...);
+        template<typename... Args>
+        reference emplace_front(Args&&...);
         void pop_back();
         void pop_front();
 
+        template<typename... Args>
+        iterator emplace(const_iterator, Args&&...);
+        iterator insert(const_iterator pos, const value_type& value) { return emplace(pos, value); }
+        iterator insert(const_iterator pos, value_type&& value) { return emplace(pos, std::move(value)); }
+        iterator insert(const_iterator, size_type, const value_type&);
+        template<typename InputIt>
+        iterator insert(const_iterator pos, InputIt first, InputIt last)
+        {
+            // insert(pos, 5, 3) lands here too: treat two integers as (count, value).
+            using is_int_type = typename __Is_Integral_type_traits<InputIt>::is_int;
+            return __insert_dispatch(pos, first, last, is_int_type());
+        }
+        iterator insert(const_iterator pos, initializer_list<value_type> ilist)
+        {
+            return insert(pos, ilist.begin(), ilist.end());
+        }
+
+        iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+        iterator erase(const_iterator, const_iterator);
+
+        void resize(size_type count) { resize(count, value_type()); }
+        void resize(size_type count, const value_type& value)
+        {
+            size_type n = size();
+            if (count < n)
+                erase(__start + difference_type(count), __finish);
+            else
+                insert(__finish, count - n, value);
+        }
+
+        void swap(tdeque<T, BuffSize, Allocator>&);
+
     protected:
         using map_pointer = value_type**;
+        using map_allocator_type = typename Allocator::template rebind<pointer>::other;
+        using __alloc_traits = tallocator_traits<Allocator>;
 
         iterator __start;   // The first element
         iterator __finish;  // The next one of the last element
 
         map_pointer __map;
         size_type __map_size;
-        size_type __size;
 
-        tallocator<value_type> __data_allocator;
-        tallocator<pointer> __map_allocator;
+        Allocator __data_allocator;
+        map_allocator_type __map_allocator;
+
+        pointer __spare[__DEQUE_CACHE_MAX];             // emptied buffers, LIFO
+        size_type __spare_count = 0;
+        size_type __spare_depth = __DEQUE_CACHE_DEPTH;
+
+        static size_type __buffer_size() { return iterator::buffer_size(); }
+
+        // Every buffer comes from / goes back through these two.
+        pointer __allocate_buffer()
+        {
+            if (__spare_count != 0)
+                return __spare[--__spare_count];
+            return __data_allocator.allocate(__buffer_size());
+        }
+        void __deallocate_buffer(pointer p) noexcept
+        {
+            if (__spare_count < __spare_depth)
+                __spare[__spare_count++] = p;
+            else
+                __data_allocator.deallocate(p, __buffer_size());
+        }
+        // Keep at most 'keep' spares.
+        void __release_buffer_cache(size_type keep) noexcept
+        {
+            while (__spare_count > keep)
+                __data_allocator.deallocate(__spare[--__spare_count], __buffer_size());
+        }
+
+        template<typename... Args>
+        static void __construct(pointer p, Args&&... args)
+        {
+            ::new((void*)p) T(std::forward<Args>(args)...);
+        }
+
+        // Drop the cast-away const of a const_iterator(it points into *this).
+        static iterator __mutable(const_iterator it)
+        {
+            iterator res;
+            res.__cur = const_cast<pointer>(it.__cur);
+            res.__first = const_cast<pointer>(it.__first);
+            res.__last = const_cast<pointer>(it.__last);
+            res.__node = it.__node;
+            return res;
+        }
 
         void __fill_initialize(size_type, const value_type&);
         void __create_map_and_nodes(size_type);
-        void __push_back_aux(value_type&&);
-        void __push_front_aux(value_type&&);
-        // void __pop_back_aux();
-        // void __pop_front_aux();
+        void __destroy_map_and_nodes() noexcept;
+        template<typename... Args>
+        void __emplace_back_aux(Args&&...);
+        template<typename... Args>
+        void __emplace_front_aux(Args&&...);
+        void __pop_back_aux();
+        void __pop_front_aux();
+
+        void __reserve_map_at_back(size_type nodes_to_add = 1)
+        {
+            if (nodes_to_add + 1 > __map_size - size_type(__finish.__node - __map))
+                __reallocate_map(nodes_to_add, false);
+        }
+        void __reserve_map_at_front(size_type nodes_to_add = 1)
+        {
+            if (nodes_to_add > size_type(__start.__node - __map))
+                __reallocate_map(nodes_to_add, true);
+        }
         void __reallocate_map(size_type, bool);
+
+        /*
+            Middle insertion: the new elements are pushed at the nearer end,
+            then rotated into place, so only min(index, size() - index)
+            elements move.
+        */
+        static void __reverse(iterator first, iterator last)
+        {
+            while (first != last && first != --last)
+            {
+                std::swap(*first, *last);
+                ++first;
+            }
+        }
+        static void __rotate(iterator first, iterator middle, iterator last)
+        {
+            __reverse(first, middle);
+            __reverse(middle, last);
+            __reverse(first, last);
+        }
+
+        // 'count' new elements sit at the front(or back) now; move them to 'index'.
+        iterator __place_front(size_type count, size_type index)
+        {
+            __rotate(__start, __start + difference_type(count), __start + difference_type(count + index));
+            return __start + difference_type(index);
+        }
+        iterator __place_back(size_type count, size_type index)
+        {
+            __rotate(__start + difference_type(index), __finish - difference_type(count), __finish);
+            return __start + difference_type(index);
+        }
+
+        // A push threw part-way: drop the 'count' elements already pushed.
+        void __unpush_front(size_type count) noexcept
+        {
+            for (; count > 0; --count)
+                pop_front();
+        }
+        void __unpush_back(size_type count) noexcept
+        {
+            for (; count > 0; --count)
+                pop_back();
+        }
+
+        template<typename InputIt>
+        iterator __insert_dispatch(const_iterator pos, InputIt first, InputIt last, __false_type)
+        {
+            size_type index = size_type(pos - const_iterator(__start));
+            size_type count = 0;
+            if (index < size() / 2)
+            {
+                // Pushed in reverse; flip the block back before rotating it in.
+                try
+                {
+                    for (; first != last; ++first, ++count)
+                        emplace_front(*first);
+                }
+                catch (...)
+                {
+                    __unpush_front(count);
+                    throw;
+                }
+                __reverse(__start, __start + difference_type(count));
+                return __place_front(count, index);
+            }
+            try
+            {
+                for (; first != last; ++first, ++count)
+                    emplace_back(*first);
+            }
+            catch (...)
+            {
+                __unpush_back(count);
+                throw;
+            }
+            return __place_back(count, index);
+        }
+
+        template<typename Integer>
+        iterator __insert_dispatch(const_iterator pos, Integer count, Integer value, __true_type)
+        {
+            return insert(pos, (size_type)count, (value_type)value);
+        }
+
+        template<typename InputIt>
+        void __assign_dispatch(InputIt first, InputIt last, __false_type)
+        {
+            // Reuse the live elements, then trim or append the rest.
+            iterator cur = __start;
+            for (; cur != __finish && first != last; ++cur, ++first)
+                *cur = *first;
+            if (first == last)
+                erase(cur, __finish);
+            else
+                insert(__finish, first, last);
+        }
+
+        template<typename Integer>
+        void __assign_dispatch(Integer count, Integer value, __true_type)
+        {
+            assign((size_type)count, (value_type)value);
+        }
+
+        void __swap_storage(tdeque<T, BuffSize, Allocator>& x) noexcept
+        {
+            toy_std::swap(__start, x.__start);
+            toy_std::swap(__finish, x.__finish);
+            toy_std::swap(__map, x.__map);
+            toy_std::swap(__map_size, x.__map_size);
+            // The spares were drawn from the same allocator as the buffers.
+            for (size_type i = 0; i < __DEQUE_CACHE_MAX; ++i)
+                toy_std::swap(__spare[i], x.__spare[i]);
+            toy_std::swap(__spare_count, x.__spare_count);
+            toy_std::swap(__spare_depth, x.__spare_depth);
+        }
+
+        void __swap_alloc(tdeque<T, BuffSize, Allocator>& x, __true_type)
+        {
+            toy_std::swap(__data_allocator, x.__data_allocator);
+            toy_std::swap(__map_allocator, x.__map_allocator);
+        }
+        void __swap_alloc(tdeque<T, BuffSize, Allocator>&, __false_type) { }
+
+        void __copy_assign_alloc(const tdeque<T, BuffSize, Allocator>& x, __true_type)
+        {
+            if (__allocator_equal(__data_allocator, x.__data_allocator))
+                return;
+            // Our memory must go back through the old allocator first.
+            __destroy_map_and_nodes();
+            __data_allocator = x.__data_allocator;
+            __map_allocator = x.__map_allocator;
+            __create_map_and_nodes(0);
+        }
+        void __copy_assign_alloc(const tdeque<T, BuffSize, Allocator>&, __false_type) { }
+
+        void __move_assign(tdeque<T, BuffSize, Allocator>& x, __true_type)
+        {
+            __destroy_map_and_nodes();
+            __data_allocator = x.__data_allocator;
+            __map_allocator = x.__map_allocator;
+            __create_map_and_nodes(0);
+            __swap_storage(x);
+        }
+        void __move_assign(tdeque<T, BuffSize, Allocator>& x, __false_type)
+        {
+            // Buffers may only change hands between equal allocators.
+            if (__allocator_equal(__data_allocator, x.__data_allocator))
+            {
+                __swap_storage(x);
+                x.clear();
+            }
+            else
+            {
+                assign(std::make_move_iterator(x.begin()), std::make_move_iterator(x.end()));
+                x.clear();
+            }
+        }
     };
 
-    template<typename T, size_t BuffSize>
-    void 
-    tdeque<T, BuffSize>::__fill_initialize(size_type n, const value_type& value)
+    template<typename T, size_t BuffSize, typename Allocator>
+    void
+    tdeque<T, BuffSize, Allocator>::__fill_initialize(size_type n, const value_type& value)
     {
         __create_map_and_nodes(n);
-        __size = n;
-        map_pointer cur;
-        for (cur = __start.__node; cur < __finish.__node; ++cur)
-            uninitialized_fill(*cur, *cur + iterator::buffer_size(), value);
-        uninitialized_fill(__finish.__first, __finish.__cur, value);
+        iterator cur = __start;
+        try
+        {
+            for (; cur != __finish; ++cur)
+                __construct(cur.__cur, value);
+        }
+        catch (...)
+        {
+            toy_std::destroy(__start, cur);
+            __finish = __start;
+            throw;
+        }
     }
 
-    template<typename T, size_t BuffSize>
+    template<typename T, size_t BuffSize, typename Allocator>
     void
-    tdeque<T, BuffSize>::__create_map_and_nodes(size_type num_elements)
+    tdeque<T, BuffSize, Allocator>::__create_map_and_nodes(size_type num_elements)
     {
-        size_type num_nodes = num_elements / iterator::buffer_size() + 1;
-        __map_size = max(8, num_nodes + 2);
+        size_type num_nodes = num_elements / __buffer_size() + 1;
+        __map_size = toy_std::max(size_type(8), num_nodes + 2);
         __map = __map_allocator.allocate(__map_size);
 
-        map_pointer  node_start = __map + (__map_size - num_nodes) / 2;
+        map_pointer node_start = __map + (__map_size - num_nodes) / 2;
         map_pointer node_finish = node_start + num_nodes - 1;
 
-        map_pointer cur;
-        for (cur = node_start; cur <= node_finish; ++cur)
-            *cur = __data_allocator(iterator::buffer_size());
+        map_pointer cur = node_start;
+        try
+        {
+            for (; cur <= node_finish; ++cur)
+                *cur = __allocate_buffer();
+        }
+        catch (...)
+        {
+            while (cur != node_start)
+                __deallocate_buffer(*--cur);
+            __map_allocator.deallocate(__map, __map_size);
+            __map = nullptr;
+            __map_size = 0;
+            throw;
+        }
 
         __start.set_node(node_start);
         __finish.set_node(node_finish);
         __start.__cur = __start.__first;
-        __finish.__cur = __finish.__first + num_elements % iterator::buffer_size();
+        __finish.__cur = __finish.__first + num_elements % __buffer_size();
+    }
+
+    // Elements, buffers and map; *this must be rebuilt(__create_map_and_nodes) afterwards.
+    template<typename T, size_t BuffSize, typename Allocator>
+    void
+    tdeque<T, BuffSize, Allocator>::__destroy_map_and_nodes() noexcept
+    {
+        clear();
+        __deallocate_buffer(*__start.__node);
+        __release_buffer_cache(0);
+        __map_allocator.deallocate(__map, __map_size);
+        __map = nullptr;
+        __map_size = 0;
     }
 
-    template<typename T, size_t BuffSize>
-    inline
-    tdeque<T, BuffSize>::tdeque(size_type count, const value_type& value):
-    __start(), __finish(), __map(), __map_size(), __size(0)
+    template<typename T, size_t BuffSize, typename Allocator>
+    tdeque<T, BuffSize, Allocator>::tdeque(size_type count, const value_type& value, const Allocator& alloc):
+    __start(), __finish(), __map(), __map_size(0),
+    __data_allocator(alloc), __map_allocator(alloc)
     {
         __fill_initialize(count, value);
     }
 
-    template<typename T, size_t BuffSize>
-    tdeque<T, BuffSize>::tdeque(const tdeque<T, BuffSize>& other):
-    __start(), __finish(), __map(), __map_size(), __size(other.__size)
+    template<typename T, size_t BuffSize, typename Allocator>
+    tdeque<T, BuffSize, Allocator>::tdeque(const tdeque<T, BuffSize, Allocator>& other):
+    __start(), __finish(), __map(), __map_size(0),
+    __data_allocator(__alloc_traits::select_on_container_copy_construction(other.__data_allocator)),
+    __map_allocator(__data_allocator)
     {
-        __create_map_and_nodes(other.__size);
-        auto cur = __start, o_cur = other.__start;
-        while (o_cur != other.__finish)
+        __create_map_and_nodes(other.size());
+        iterator cur = __start;
+        try
         {
-            *cur = *o_cur;
-            o_cur++;
-            cur++;
+            for (const_iterator o_cur = other.begin(); o_cur != other.end(); ++o_cur, ++cur)
+                __construct(cur.__cur, *o_cur);
+        }
+        catch (...)
+        {
+            toy_std::destroy(__start, cur);
+            __finish = __start;
+            throw;
         }
-        __finish = cur;
     }
 
-    template<typename T, size_t BuffSize>
-    tdeque<T, BuffSize>::tdeque(tdeque<T, BuffSize>&& other) :
-    __start(other.__start), __finish(other.__finish), 
-    __map(other.__map), __map_size(other.__map_size),
-    __size(other.__size),
-    __map_allocator(other.__map_allocator), __data_allocator(other.__data_allocator)
+    template<typename T, size_t BuffSize, typename Allocator>
+    tdeque<T, BuffSize, Allocator>::tdeque(tdeque<T, BuffSize, Allocator>&& other) :
+    __start(), __finish(), __map(), __map_size(0),
+    __data_allocator(other.__data_allocator), __map_allocator(other.__map_allocator)
     {
-        other.__start = iterator();
-        other.__finish = iterator();
-        other.__map = nullptr;
-        other.__map_size = 0;
-        other.__size = 0;
-        __map_allocator = tallocator<T*>();
-        __data_allocator = tallocator<T>();
+        __create_map_and_nodes(0);
+        __swap_storage(other);
     }
 
-    template<typename T, size_t BuffSize>
+    template<typename T, size_t BuffSize, typename Allocator>
+    tdeque<T, BuffSize, Allocator>&
+    tdeque<T, BuffSize, Allocator>::operator=(const tdeque<T, BuffSize, Allocator>& other)
+    {
+        if (this != &other)
+        {
+            __copy_assign_alloc(other, typename __alloc_traits::propagate_on_container_copy_assignment());
+            assign(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    template<typename T, size_t BuffSize, typename Allocator>
+    tdeque<T, BuffSize, Allocator>&
+    tdeque<T, BuffSize, Allocator>::operator=(tdeque<T, BuffSize, Allocator>&& other)
+    {
+        if (this != &other)
+            __move_assign(other, typename __alloc_traits::propagate_on_container_move_assignment());
+        return *this;
+    }
+
+    template<typename T, size_t BuffSize, typename Allocator>
+    void
+    tdeque<T, BuffSize, Allocator>::swap(tdeque<T, BuffSize, Allocator>& other)
+    {
+        // Without propagate_on_container_swap the allocators must be equal.
+        __swap_storage(other);
+        __swap_alloc(other, typename __alloc_traits::propagate_on_container_swap());
+    }
+
+    // Keeps one(the first) buffer, like an empty deque has.
+    template<typename T, size_t BuffSize, typename Allocator>
     void
-    tdeque<T, BuffSize>::push_back(value_type&& value)
+    tdeque<T, BuffSize, Allocator>::clear() noexcept
+    {
+        if (__start.__node != __finish.__node)
+        {
+            toy_std::destroy(__start.__cur, __start.__last);
+            for (map_pointer node = __start.__node + 1; node < __finish.__node; ++node)
+            {
+                toy_std::destroy(*node, *node + __buffer_size());
+                __deallocate_buffer(*node);
+            }
+            toy_std::destroy(__finish.__first, __finish.__cur);
+            __deallocate_buffer(__finish.__first);
+        }
+        else
+            toy_std::destroy(__start.__cur, __finish.__cur);
+        __finish = __start;
+    }
+
+    template<typename T, size_t BuffSize, typename Allocator>
+    template<typename... Args>
+    typename tdeque<T, BuffSize, Allocator>::reference
+    tdeque<T, BuffSize, Allocator>::emplace_back(Args&&... args)
     {
         if (__finish.__cur != __finish.__last - 1)
         {
-            construct(__finish.__cur, value);
+            __construct(__finish.__cur, std::forward<Args>(args)...);
             ++__finish.__cur;
-            __size++;
         }
         else
-            __push_back_aux(value);
+            __emplace_back_aux(std::forward<Args>(args)...);
+        return back();
     }
 
-    template<typename T, size_t BuffSize>
-    void
-    tdeque<T, BuffSize>::push_front(value_type&& value)
+    template<typename T, size_t BuffSize, typename Allocator>
+    template<typename... Args>
+    typename tdeque<T, BuffSize, Allocator>::reference
+    tdeque<T, BuffSize, Allocator>::emplace_front(Args&&... args)
     {
         if (__start.__cur != __start.__first)
         {
-            construct(__start.__cur - 1, value);
+            __construct(__start.__cur - 1, std::forward<Args>(args)...);
             --__start.__cur;
-            __size++;
         }
         else
-            __push_front_aux(value);
+            __emplace_front_aux(std::forward<Args>(args)...);
+        return front();
     }
 
-    template<typename T, size_t BuffSize>
+    template<typename T, size_t BuffSize, typename Allocator>
     void
-    tdeque<T, BuffSize>::pop_back()
+    tdeque<T, BuffSize, Allocator>::pop_back()
     {
         if (__finish.__cur != __finish.__first)
         {
             --__finish.__cur;
-            destroy(__finish.__cur);
-            --__size;
+            toy_std::destroy(__finish.__cur);
         }
         else
-            //__pop_back_aux();
-        {
-            __finish.set_node(__finish.__node - 1);
-            __finish.__cur = __finish.__last - 1;
-            destroy(__finish.__cur);
-            --__size;
-        }
+            __pop_back_aux();
     }
 
-    template<typename T, size_t BuffSize>
+    template<typename T, size_t BuffSize, typename Allocator>
     void
-    tdeque<T, BuffSize>::pop_front()
+    tdeque<T, BuffSize, Allocator>::pop_front()
     {
         if (__start.__cur != __start.__last - 1)
         {
-            destroy(__start.__cur);
-            __start.__cur++;
-            --__size;
+            toy_std::destroy(__start.__cur);
+            ++__start.__cur;
         }
         else
-            //__pop_front_aux();
-        {
-            destroy(__start.__cur);
-            __start.set_node(__start.__node + 1);
-            __start.__cur = __start.__first;
-            --__size;
-        }
+            __pop_front_aux();
     }
 
-    template<typename T, size_t BuffSize>
+    // The last slot of the last buffer gets used: hang a fresh buffer after it.
+    template<typename T, size_t BuffSize, typename Allocator>
+    template<typename... Args>
     void
-    tdeque<T, BuffSize>::__push_back_aux(value_type&& value)
+    tdeque<T, BuffSize, Allocator>::__emplace_back_aux(Args&&... args)
     {
-        if (__finish.__node + 1 == __map[__map_size - 1])
-            __reallocate_map(1, false);
-        construct(__finish.__cur, value);
+        __reserve_map_at_back();
+        *(__finish.__node + 1) = __allocate_buffer();
+        try
+        {
+            __construct(__finish.__cur, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            __deallocate_buffer(*(__finish.__node + 1));
+            throw;
+        }
         __finish.set_node(__finish.__node + 1);
         __finish.__cur = __finish.__first;
     }
 
-    template<typename T, size_t BuffSize>
+    template<typename T, size_t BuffSize, typename Allocator>
+    template<typename... Args>
     void
-    tdeque<T, BuffSize>::__push_front_aux(value_type&& value)
+    tdeque<T, BuffSize, Allocator>::__emplace_front_aux(Args&&... args)
     {
-        if (__start.__node == __map[0])
-            __reallocate_map(1, true);
+        __reserve_map_at_front();
+        *(__start.__node - 1) = __allocate_buffer();
+        try
+        {
+            __construct(*(__start.__node - 1) + (__buffer_size() - 1), std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            __deallocate_buffer(*(__start.__node - 1));
+            throw;
+        }
         __start.set_node(__start.__node - 1);
         __start.__cur = __start.__last - 1;
-        construct(__start.__cur, value);
     }
 
-    /*
-    template<typename T, size_t BuffSize>
+    // The last buffer is empty: give it back and step into the previous one.
+    template<typename T, size_t BuffSize, typename Allocator>
     void
-    tdeque<T, BuffSize>::__pop_back_aux()
+    tdeque<T, BuffSize, Allocator>::__pop_back_aux()
     {
-        
+        __deallocate_buffer(__finish.__first);
+        __finish.set_node(__finish.__node - 1);
+        __finish.__cur = __finish.__last - 1;
+        toy_std::destroy(__finish.__cur);
     }
 
-    template<typename T, size_t BuffSize>
+    // The first buffer's last element goes: give the buffer back.
+    template<typename T, size_t BuffSize, typename Allocator>
     void
-    tdeque<T, BuffSize>::__pop_front_aux()
+    tdeque<T, BuffSize, Allocator>::__pop_front_aux()
     {
+        toy_std::destroy(__start.__cur);
+        __deallocate_buffer(__start.__first);
+        __start.set_node(__start.__node + 1);
+        __start.__cur = __start.__first;
+    }
 
+    template<typename T, size_t BuffSize, typename Allocator>
+    template<typename... Args>
+    typename tdeque<T, BuffSize, Allocator>::iterator
+    tdeque<T, BuffSize, Allocator>::emplace(const_iterator pos, Args&&... args)
+    {
+        size_type index = size_type(pos - const_iterator(__start));
+        if (index < size() / 2)
+        {
+            emplace_front(std::forward<Args>(args)...);
+            return __place_front(1, index);
+        }
+        emplace_back(std::forward<Args>(args)...);
+        return __place_back(1, index);
     }
-    */
-    
-    template<typename T, size_t BuffSize>
+
+    template<typename T, size_t BuffSize, typename Allocator>
+    typename tdeque<T, BuffSize, Allocator>::iterator
+    tdeque<T, BuffSize, Allocator>::insert(const_iterator pos, size_type count, const value_type& value)
+    {
+        size_type index = size_type(pos - const_iterator(__start));
+        value_type copy(value);     // 'value' may be one of ours
+        size_type i = 0;
+        if (index < size() / 2)
+        {
+            try
+            {
+                for (; i < count; ++i)
+                    emplace_front(copy);
+            }
+            catch (...)
+            {
+                __unpush_front(i);
+                throw;
+            }
+            return __place_front(count, index);
+        }
+        try
+        {
+            for (; i < count; ++i)
+                emplace_back(copy);
+        }
+        catch (...)
+        {
+            __unpush_back(i);
+            throw;
+        }
+        return __place_back(count, index);
+    }
+
+    // Close the gap from the shorter side, then pop the leftovers there.
+    template<typename T, size_t BuffSize, typename Allocator>
+    typename tdeque<T, BuffSize, Allocator>::iterator
+    tdeque<T, BuffSize, Allocator>::erase(const_iterator cfirst, const_iterator clast)
+    {
+        iterator first = __mutable(cfirst), last = __mutable(clast);
+        difference_type count = last - first;
+        difference_type before = first - __start;
+        if (count == 0)
+            return first;
+        if (before < (difference_type(size()) - count) / 2)
+        {
+            iterator dst = last, src = first;
+            while (src != __start)
+                *--dst = std::move(*--src);
+            for (difference_type i = 0; i < count; ++i)
+                pop_front();
+        }
+        else
+        {
+            iterator dst = first;
+            for (iterator src = last; src != __finish; ++src, ++dst)
+                *dst = std::move(*src);
+            for (difference_type i = 0; i < count; ++i)
+                pop_back();
+        }
+        return __start + before;
+    }
+
+    template<typename T, size_t BuffSize, typename Allocator>
     void
-    tdeque<T, BuffSize>::__reallocate_map(size_type nodes_to_add, bool add_at_front)
+    tdeque<T, BuffSize, Allocator>::__reallocate_map(size_type nodes_to_add, bool add_at_front)
     {
         size_type old_num_nodes = __finish.__node - __start.__node + 1;
         size_type new_num_nodes = old_num_nodes + nodes_to_add;
@@ -419,17 +973,18 @@ namespace toy_std
             new_node_start = __map + (__map_size - new_num_nodes) / 2
                              + (add_at_front ? nodes_to_add : 0);
             if (new_node_start < __start.__node)
-                copy(__start.__node, __finish.__node + 1, new_node_start);
+                toy_std::copy(__start.__node, __finish.__node + 1, new_node_start);
             else
-                copy_backward(__start.__node, __finish.__node + 1, new_node_start + old_num_nodes);
+                toy_std::copy_backward(__start.__node, __finish.__node + 1, new_node_start + old_num_nodes);
 
         }
         else
         {
-            size_type new_map_size = __map_size + max(__map_size, nodes_to_add) + 2;
+            size_type new_map_size = __map_size + toy_std::max(__map_size, nodes_to_add) + 2;
             map_pointer new_map = __map_allocator.allocate(new_map_size);
             new_node_start = new_map + (new_map_size - new_num_nodes) / 2
                              + (add_at_front ? nodes_to_add : 0);
+            toy_std::copy(__start.__node, __finish.__node + 1, new_node_start);
             __map_allocator.deallocate(__map, __map_size);
             __map = new_map;
             __map_size = new_map_size;
@@ -438,4 +993,26 @@ namespace toy_std
         __start.set_node(new_node_start);
         __finish.set_node(new_node_start + old_num_nodes - 1);
     }
-}
\ No newline at end of file
+
+    /* Non-member functions */
+    template<typename T, size_t BuffSize, typename Allocator>
+    bool operator==(const tdeque<T, BuffSize, Allocator>& a, const tdeque<T, BuffSize, Allocator>& b)
+    {
+        if (a.size() != b.size())
+            return false;
+        auto q = b.begin();
+        for (auto p = a.begin(); p != a.end(); ++p, ++q)
+            if (!(*p == *q))
+                return false;
+        return true;
+    }
+
+    template<typename T, size_t BuffSize, typename Allocator>
+    inline bool operator!=(const tdeque<T, BuffSize, Allocator>& a, const tdeque<T, BuffSize, Allocator>& b)
+    {
+        return !(a == b);
+    }
+
+    template<typename T, size_t BuffSize, typename Allocator>
+    inline void swap(tdeque<T, BuffSize, Allocator>& a, tdeque<T, BuffSize, Allocator>& b) { a.swap(b); }
+}
@@ -0,0 +1,331 @@
+/*
+    Project:        Toy_Intrusive_List
+    Description:    doubly-linked list threaded through hooks inside the elements
+    Update date:    2026/10/17
+    Author:         Zhuofan Zhang
+
+    Model:
+
+        __head <--> | hook | obj ... | <--> | hook | obj ... | <--> __head
+
+        The same sentinel ring as tlist, but the links live in the elements
+        themselves(a 'tlist_hook'), so the list never allocates, copies or
+        destroys anything: it only links objects that live elsewhere.
+
+        Hooks, either way:
+
+            struct Entry : public tlist_hook { ... };                    // base class
+            tintrusive_list<Entry> lru;
+
+            struct Entry { tlist_hook lru_hook; tlist_hook age_hook; };  // members:
+            tintrusive_list<Entry, tlist_member_hook<Entry, &Entry::lru_hook>> lru;
+                                                                         // one list per hook
+
+        An object must outlive its membership, and be in at most one list
+        per hook. erase(obj), iterator_to(obj) and moving an object within
+        or across lists(splice) are O(1): no search, no heap traffic.
+*/
+#pragma once
+#include"toy_std.hpp"
+#include"toyiterator.hpp"
+#include"toyalgo_base.hpp"
+#include<iterator>
+
+namespace toy_std
+{
+    /* Links embedded in the element; unlinked hooks point nowhere */
+    struct tlist_hook
+    {
+        tlist_hook* _prev = nullptr;
+        tlist_hook* _next = nullptr;
+
+        tlist_hook() = default;
+        // Copying an element must not copy its membership.
+        tlist_hook(const tlist_hook&) noexcept { }
+        tlist_hook& operator=(const tlist_hook&) noexcept { return *this; }
+
+        bool is_linked() const noexcept { return _next != nullptr; }
+    };
+
+    /* Hook <-> element: T derives from tlist_hook */
+    template<typename T>
+    struct tlist_base_hook
+    {
+        using value_type = T;
+        static tlist_hook* to_hook(T* p) noexcept { return static_cast<tlist_hook*>(p); }
+        static T* to_value(tlist_hook* h) noexcept { return static_cast<T*>(h); }
+    };
+
+    /* Hook <-> element: 'Hook' is a tlist_hook member of T */
+    template<typename T, tlist_hook T::*Hook>
+    struct tlist_member_hook
+    {
+        using value_type = T;
+        static tlist_hook* to_hook(T* p) noexcept { return &(p->*Hook); }
+        static T* to_value(tlist_hook* h) noexcept
+        {
+            // Offset of the member, taken on a never-constructed buffer.
+            alignas(T) static char probe[sizeof(T)];
+            T* fake = reinterpret_cast<T*>(probe);
+            size_t offset = reinterpret_cast<char*>(&(fake->*Hook)) - probe;
+            return reinterpret_cast<T*>(reinterpret_cast<char*>(h) - offset);
+        }
+    };
+
+    /* Intrusive list iterator: Bidirection Iterator */
+    template<typename HookTraits,
+             typename Pointer = typename HookTraits::value_type*,
+             typename Reference = typename HookTraits::value_type&>
+    class __Intrusive_Iterator
+    {
+    public:
+        using __Self = __Intrusive_Iterator<HookTraits, Pointer, Reference>;
+        using iterator = __Intrusive_Iterator<HookTraits>;
+
+        using iterator_category = bidirection_iterator_tag;
+        using value_type = typename HookTraits::value_type;
+        using pointer = Pointer;
+        using reference = Reference;
+        using difference_type = ptrdiff_t;
+
+        /* Constructors */
+        __Intrusive_Iterator() : __node(nullptr) { }
+        explicit __Intrusive_Iterator(tlist_hook* node) : __node(node) { }
+        // iterator -> const_iterator(the copy constructor of iterator itself)
+        __Intrusive_Iterator(const iterator& x) : __node(x.__node) { }
+        __Intrusive_Iterator& operator=(const __Intrusive_Iterator&) = default;
+
+        /* Operators */
+        reference operator*() const { return *HookTraits::to_value(__node); }
+        pointer operator->() const { return HookTraits::to_value(__node); }
+        __Self& operator++() { __node = __node->_next; return *this; }
+        __Self operator++(int) { __Self tmp = *this; ++*this; return tmp; }
+        __Self& operator--() { __node = __node->_prev; return *this; }
+        __Self operator--(int) { __Self tmp = *this; --*this; return tmp; }
+        bool operator==(const __Self& b) const { return __node == b.__node; }
+        bool operator!=(const __Self& b) const { return !(*this == b); }
+
+        tlist_hook* __node;
+    };
+
+    /* tIntrusive_list */
+    template<typename T, typename HookTraits = tlist_base_hook<T>>
+    class tintrusive_list
+    {
+    public:
+        /* Member types */
+        using value_type = T;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = value_type&;
+        using const_reference = const value_type&;
+        using pointer = value_type*;
+        using const_pointer = const value_type*;
+        using iterator = __Intrusive_Iterator<HookTraits>;
+        using const_iterator = __Intrusive_Iterator<HookTraits, const T*, const T&>;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+        /* Constructors */
+        tintrusive_list() noexcept : __size(0) { __reset_head(); }
+        tintrusive_list(const tintrusive_list&) = delete;
+        tintrusive_list(tintrusive_list&& other) noexcept : tintrusive_list() { __steal(other); }
+
+        tintrusive_list& operator=(const tintrusive_list&) = delete;
+        tintrusive_list& operator=(tintrusive_list&& other) noexcept
+        {
+            if (this != &other)
+            {
+                clear();
+                __steal(other);
+            }
+            return *this;
+        }
+
+        /* Destructor */
+        // The elements stay where they are, only unlinked.
+        ~tintrusive_list() noexcept { clear(); }
+
+        /* Capacity */
+        bool empty() const noexcept { return __size == 0; }
+        size_type size() const noexcept { return __size; }
+
+        /* Element Access */
+        reference front() { return *HookTraits::to_value(__head._next); }
+        const_reference front() const { return *HookTraits::to_value(__head._next); }
+        reference back() { return *HookTraits::to_value(__head._prev); }
+        const_reference back() const { return *HookTraits::to_value(__head._prev); }
+
+        /* Iterators */
+        iterator begin() noexcept { return iterator(__head._next); }
+        iterator end() noexcept { return iterator(&__head); }
+        const_iterator begin() const noexcept { return const_iterator(iterator(__head._next)); }
+        const_iterator end() const noexcept { return const_iterator(iterator(const_cast<tlist_hook*>(&__head))); }
+        const_iterator cbegin() const noexcept { return begin(); }
+        const_iterator cend() const noexcept { return end(); }
+
+        reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+        reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+        const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(end()); }
+        const_reverse_iterator crend() const noexcept { return const_reverse_iterator(begin()); }
+
+        // The position of an element known to be in this list: O(1).
+        iterator iterator_to(reference value) noexcept { return iterator(HookTraits::to_hook(&value)); }
+        const_iterator iterator_to(const_reference value) const noexcept
+        {
+            return const_iterator(iterator(HookTraits::to_hook(const_cast<pointer>(&value))));
+        }
+
+        /* Modifiers */
+        // Unlinks everything(and resets the hooks); nothing is destroyed.
+        void clear() noexcept
+        {
+            for (tlist_hook* p = __head._next; p != &__head; )
+            {
+                tlist_hook* next = p->_next;
+                p->_prev = p->_next = nullptr;
+                p = next;
+            }
+            __reset_head();
+        }
+
+        iterator insert(const_iterator pos, reference value) noexcept
+        {
+            tlist_hook* h = HookTraits::to_hook(&value);
+            __link_before(pos.__node, h);
+            ++__size;
+            return iterator(h);
+        }
+        void push_back(reference value) noexcept { insert(end(), value); }
+        void push_front(reference value) noexcept { insert(begin(), value); }
+
+        iterator erase(const_iterator pos) noexcept
+        {
+            tlist_hook* next = pos.__node->_next;
+            __unlink(pos.__node);
+            --__size;
+            return iterator(next);
+        }
+        iterator erase(const_iterator first, const_iterator last) noexcept
+        {
+            while (first != last)
+                first = erase(first);
+            return iterator(last.__node);
+        }
+        // Unlink 'value' from wherever it is in this list.
+        void erase(reference value) noexcept { erase(iterator_to(value)); }
+        void pop_front() noexcept { erase(begin()); }
+        void pop_back() noexcept { erase(iterator(__head._prev)); }
+
+        void swap(tintrusive_list& other) noexcept
+        {
+            // Sentinels live inside the lists: go through a third one.
+            tintrusive_list tmp;
+            tmp.__steal(*this);
+            __steal(other);
+            other.__steal(tmp);
+        }
+
+        /* Operations */
+        // Move the whole of 'other' before 'pos'.
+        void splice(const_iterator pos, tintrusive_list& other) noexcept
+        {
+            if (&other == this || other.empty())
+                return;
+            __transfer(pos.__node, other.__head._next, &other.__head);
+            __size += other.__size;
+            other.__size = 0;
+        }
+        // Move one element(e.g. to the front of an LRU list).
+        void splice(const_iterator pos, tintrusive_list& other, const_iterator it) noexcept
+        {
+            tlist_hook* next = it.__node->_next;
+            if (pos.__node == it.__node || pos.__node == next)
+                return;
+            __transfer(pos.__node, it.__node, next);
+            ++__size;
+            --other.__size;
+        }
+
+        template<typename UnaryPredicate>
+        void remove_if(UnaryPredicate pred)
+        {
+            for (iterator it = begin(); it != end(); )
+            {
+                if (pred(*it))
+                    it = erase(it);
+                else
+                    ++it;
+            }
+        }
+
+        void reverse() noexcept
+        {
+            tlist_hook* p = &__head;
+            do
+            {
+                toy_std::swap(p->_prev, p->_next);
+                p = p->_prev;       // the old '_next'
+            } while (p != &__head);
+        }
+
+    protected:
+        tlist_hook __head;
+        size_type __size;
+
+        void __reset_head() noexcept
+        {
+            __head._prev = &__head;
+            __head._next = &__head;
+            __size = 0;
+        }
+
+        // Take over other's elements; *this must be empty.
+        void __steal(tintrusive_list& other) noexcept
+        {
+            if (other.empty())
+                return;
+            __head._next = other.__head._next;
+            __head._prev = other.__head._prev;
+            __head._next->_prev = &__head;
+            __head._prev->_next = &__head;
+            __size = other.__size;
+            other.__reset_head();
+        }
+
+        static void __link_before(tlist_hook* pos, tlist_hook* h) noexcept
+        {
+            h->_next = pos;
+            h->_prev = pos->_prev;
+            pos->_prev->_next = h;
+            pos->_prev = h;
+        }
+
+        static void __unlink(tlist_hook* h) noexcept
+        {
+            h->_prev->_next = h->_next;
+            h->_next->_prev = h->_prev;
+            h->_prev = h->_next = nullptr;
+        }
+
+        // Relink [first, last) before 'pos'(see tlist::__transfer).
+        static void __transfer(tlist_hook* pos, tlist_hook* first, tlist_hook* last) noexcept
+        {
+            if (pos == last || first == last)
+                return;
+            tlist_hook* before_pos = pos->_prev;
+            tlist_hook* tail = last->_prev;
+
+            first->_prev->_next = last;
+            last->_prev = first->_prev;
+
+            before_pos->_next = first;
+            first->_prev = before_pos;
+            tail->_next = pos;
+            pos->_prev = tail;
+        }
+    };
+
+    template<typename T, typename HookTraits>
+    inline void swap(tintrusive_list<T, HookTraits>& a, tintrusive_list<T, HookTraits>& b) noexcept { a.swap(b); }
+}
@@ -1,6 +1,6 @@
 /*
     Project:        Toy_List
-    Update date:    2020/1/15
+    Update date:    2026/10/17
     Author:         Zhuofan Zhang
 */
 #pragma once
@@ -8,6 +8,7 @@
 #include"toymemory.hpp"
 #include"toyiterator.hpp"
 #include"toyalgo_base.hpp"
+#include"toy_stl_function.hpp"
 
 using std::initializer_list;
 
@@ -140,32 +141,33 @@ namespace toy_std
         using __tNode_Pointer = __tList_Node<T>*;
 
         /* Non-member functions */
-        template<typename T, typename Alloc>
-        friend bool operator==(const tlist<T, Alloc>&, const tlist<T, Alloc>&);
+        template<typename X, typename A>
+        friend bool operator==(const tlist<X, A>&, const tlist<X, A>&);
 
-        template<typename T, typename Alloc>
-        friend inline bool operator!=(const tlist<T, Alloc>&, const tlist<T, Alloc>&);
+        template<typename X, typename A>
+        friend inline bool operator!=(const tlist<X, A>&, const tlist<X, A>&);
 
-        template<typename T, typename Alloc>
-        friend bool operator<(const tlist<T, Alloc>&, const tlist<T, Alloc>&);
+        template<typename X, typename A>
+        friend bool operator<(const tlist<X, A>&, const tlist<X, A>&);
 
-        template<typename T, typename Alloc>
-        friend bool operator<=(const tlist<T, Alloc>&, const tlist<T, Alloc>&);
+        template<typename X, typename A>
+        friend bool operator<=(const tlist<X, A>&, const tlist<X, A>&);
 
-        template<typename T, typename Alloc>
-        friend inline bool operator>(const tlist<T, Alloc>&, const tlist<T, Alloc>&);
+        template<typename X, typename A>
+        friend inline bool operator>(const tlist<X, A>&, const tlist<X, A>&);
 
-        template<typename T, typename Alloc>
-        friend inline bool operator>=(const tlist<T, Alloc>&, const tlist<T, Alloc>&);
+        template<typename X, typename A>
+        friend inline bool operator>=(const tlist<X, A>&, const tlist<X, A>&);
 
         /* Constructors */
         tlist();
-        tlist(size_type, const value_type&);
+        explicit tlist(const Allocator&);
+        tlist(size_type, const value_type&, const Allocator& = Allocator());
         tlist(const tlist<T, Allocator>&);
         tlist(tlist<T, Allocator>&&) noexcept;
-        tlist(initializer_list<value_type>);
+        tlist(initializer_list<value_type>, const Allocator& = Allocator());
         template<typename InputIt>
-        tlist(InputIt first, InputIt last);
+        tlist(InputIt first, InputIt last, const Allocator& = Allocator());
         tlist<T, Allocator>& operator=(const tlist<T, Allocator>&);
         tlist<T, Allocator>& operator=(tlist<T, Allocator>&&);
 
@@ -179,6 +181,8 @@ namespace toy_std
                 __alloc.deallocate(__Node, 1); 
         }
 
+        allocator_type get_allocator() const { return __alloc; }
+
         /* Capacity */
         bool empty() { return __size == 0; }
         size_type size() const noexcept { return __size; }
@@ -198,14 +202,15 @@ namespace toy_std
 
 
         /* Iterators */
-        iterator begin() noexcept { return iterator(__Node->_next); }
+        // A moved-from list has no sentinel: begin() == end() == nullptr.
+        iterator begin() noexcept { return iterator(__Node != nullptr ? __Node->_next : nullptr); }
         iterator end() noexcept { return iterator(__Node); }
-        const_iterator cbegin() const noexcept { return iterator(__Node->_next); }
+        const_iterator cbegin() const noexcept { return iterator(__Node != nullptr ? __Node->_next : nullptr); }
         const_iterator cend() const noexcept { return iterator(__Node); }
 
-        reverse_iterator rbegin() noexcept { return reverse_iterator(__Node->_prev); }
+        reverse_iterator rbegin() noexcept { return reverse_iterator(__Node != nullptr ? __Node->_prev : nullptr); }
         reverse_iterator rend() noexcept { return reverse_iterator(__Node); }
-        const_reverse_iterator crbegin() noexcept { return reverse_iterator(__Node->_prev); }
+        const_reverse_iterator crbegin() noexcept { return reverse_iterator(__Node != nullptr ? __Node->_prev : nullptr); }
         const_reverse_iterator crend() noexcept { return reverse_iterator(__Node); }
 
         /* Modifiers */
@@ -219,21 +224,61 @@ namespace toy_std
         template<typename InputIt>
         iterator insert(iterator, InputIt, InputIt);
         inline iterator insert(iterator, initializer_list<T>);
-        
 
-        void push_back(value_type&&);
-        void push_front(value_type&&);
+        template<typename... Args>
+        iterator emplace(iterator, Args&&...);
+        template<typename... Args>
+        reference emplace_back(Args&&... args) { return *emplace(end(), std::forward<Args>(args)...); }
+        template<typename... Args>
+        reference emplace_front(Args&&... args) { return *emplace(begin(), std::forward<Args>(args)...); }
+
+        void push_back(const value_type& value) { emplace(end(), value); }
+        void push_back(value_type&& value) { emplace(end(), std::move(value)); }
+        void push_front(const value_type& value) { emplace(begin(), value); }
+        void push_front(value_type&& value) { emplace(begin(), std::move(value)); }
         void pop_front();
         void pop_back();
 
         inline void clear() noexcept;
 
         /* Operations */
-        void merge(tlist<T, Allocator>&&);
+        /*
+            merge/splice move nodes between lists without allocating or
+            copying: both lists must use equal allocators(the nodes will be
+            freed by this list's).
+        */
+        void merge(tlist<T, Allocator>& other) { merge(other, less<T>()); }
+        void merge(tlist<T, Allocator>&& other) { merge(other, less<T>()); }
+        template<typename Compare>
+        void merge(tlist<T, Allocator>&, Compare);
+        template<typename Compare>
+        void merge(tlist<T, Allocator>&& other, Compare comp) { merge(other, comp); }
+
+        void splice(iterator, tlist<T, Allocator>&);
+        void splice(iterator pos, tlist<T, Allocator>&& other) { splice(pos, other); }
+        void splice(iterator, tlist<T, Allocator>&, iterator);
+        void splice(iterator pos, tlist<T, Allocator>&& other, iterator it) { splice(pos, other, it); }
+        // O(n) in the range length when 'other' is another list: the sizes need it.
+        void splice(iterator pos, tlist<T, Allocator>& other, iterator first, iterator last)
+        {
+            size_type count = 0;
+            if (&other != this)
+                for (iterator it = first; it != last; ++it)
+                    ++count;
+            splice(pos, other, first, last, count);
+        }
+        void splice(iterator pos, tlist<T, Allocator>&& other, iterator first, iterator last)
+        {
+            splice(pos, other, first, last);
+        }
+        // O(1): 'count' must be distance(first, last).
+        void splice(iterator, tlist<T, Allocator>&, iterator, iterator, size_type);
         void reverse() noexcept;
         void remove(const value_type&);
         void unique();
-        void sort();
+        void sort() { sort(less<T>()); }
+        template<typename Compare>
+        void sort(Compare);
         
 
     protected:
@@ -241,45 +286,313 @@ namespace toy_std
         Allocator __alloc;
         size_type __size;   // Since the C++11, size() is in complexity constant.
 
-        /* Dispatch Constructor */
-        template<typename __Input>
-        void __tlist_construct_dispatch(__Input first, __Input last, __false_type)
+        /*
+            clear(): when deallocate() is a no-op and T needs no destructor
+            (e.g. arena allocators) just unlink everything in O(1).
+        */
+        void __clear_aux(__true_type, __true_type) noexcept
         {
-            __Node = __alloc.allocate(1);
-            auto tmp = __Node;
-            while (first != last)
+            __Node->_prev = __Node;
+            __Node->_next = __Node;
+            __size = 0;
+        }
+
+        // Otherwise the nodes go back in batches(see __NODE_BATCH).
+        template<typename TrivialDealloc, typename TrivialDtor>
+        void __clear_aux(TrivialDealloc, TrivialDtor) noexcept
+        {
+            __tNode_Pointer batch[__NODE_BATCH];
+            size_type n = 0;
+            for (__tNode_Pointer p = __Node->_next; p != __Node; )
             {
-                tmp->_next = __alloc.allocate(1);
-                tmp->_next->_prev = tmp;
-                tmp = tmp->_next;
-                tmp->_data = *first;
-                ++first;
-                __size++;
+                toy_std::destroy(&p->_data);
+                batch[n++] = p;
+                p = p->_next;
+                if (n == __NODE_BATCH)
+                {
+                    __alloc_traits::deallocate_batch(__alloc, 1, n, batch);
+                    n = 0;
+                }
             }
+            __alloc_traits::deallocate_batch(__alloc, 1, n, batch);
+            __Node->_prev = __Node;
+            __Node->_next = __Node;
+            __size = 0;
+        }
 
-            __Node->_prev = tmp;
-            tmp->_next = __Node;
+        /*
+            sort() helpers: runs are chains linked through '_next' only and
+            ended by nullptr; '_prev' is rebuilt once at the end.
+        */
+        template<typename Compare>
+        static void __merge_runs(__tNode_Pointer, __tNode_Pointer&, Compare&);
+
+        // Relink [first, last) before 'pos'; they may belong to another list.
+        static void __transfer(__tNode_Pointer pos, __tNode_Pointer first, __tNode_Pointer last) noexcept
+        {
+            if (pos == last || first == last)
+                return;
+            __tNode_Pointer before_pos = pos->_prev;
+            __tNode_Pointer tail = last->_prev;
+
+            first->_prev->_next = last;
+            last->_prev = first->_prev;
+
+            before_pos->_next = first;
+            first->_prev = before_pos;
+            tail->_next = pos;
+            pos->_prev = tail;
         }
 
-        template<typename __Input>
-        void __tlist_construct_dispatch(__Input n, __Input value, __true_type)
+        // Hang the chains back on __Node one after another, fixing every '_prev'.
+        void __relink_runs(__tNode_Pointer* runs, size_type count) noexcept
+        {
+            __tNode_Pointer prev = __Node;
+            for (size_type i = 0; i < count; ++i)
+                for (__tNode_Pointer p = runs[i]; p != nullptr; p = p->_next)
+                {
+                    prev->_next = p;
+                    p->_prev = prev;
+                    prev = p;
+                }
+            prev->_next = __Node;
+            __Node->_prev = prev;
+        }
+
+        /* Allocator propagation(see tallocator_traits) */
+        using __alloc_traits = tallocator_traits<Allocator>;
+
+        /*
+            Bulk insertion: nodes are taken from the allocator in batches
+            of up to '__NODE_BATCH'(see allocate_batch), so building a long
+            list costs a few pool round trips instead of one per node.
+        */
+        static const size_type __NODE_BATCH = 512;
+
+        // Chain 'node' after 'prev'; the caller closes the chain.
+        static void __link_after(__tNode_Pointer prev, __tNode_Pointer node)
+        {
+            prev->_next = node;
+            node->_prev = prev;
+        }
+
+        // A node whose '_data' is built in place from 'args'.
+        template<typename... Args>
+        __tNode_Pointer __create_node(Args&&... args)
+        {
+            __tNode_Pointer p = __alloc.allocate(1);
+            try
+            {
+                toy_std::construct(&p->_data, std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                __alloc.deallocate(p, 1);
+                throw;
+            }
+            return p;
+        }
+
+        void __destroy_node(__tNode_Pointer p) noexcept
+        {
+            toy_std::destroy(&p->_data);
+            __alloc.deallocate(p, 1);
+        }
+
+        /*
+            A batch insert threw(allocation, T's constructor or the input
+            iterator): give back batch[used, held) that was never built,
+            close the chain and erase what was already linked, so the list
+            is as it was.
+        */
+        void __insert_rollback(iterator pos, __tNode_Pointer before, __tNode_Pointer prev,
+                               __tNode_Pointer* batch, size_type used, size_type held) noexcept
+        {
+            __alloc_traits::deallocate_batch(__alloc, 1, held - used, batch + used);
+            __link_after(prev, pos.__node);
+            erase(iterator(before->_next), pos);
+        }
+
+        // Insert 'count' copies of 'value' before 'pos'; returns the first one.
+        iterator __insert_fill(iterator pos, size_type count, const value_type& value)
+        {
+            __tNode_Pointer batch[__NODE_BATCH];
+            __tNode_Pointer prev = pos.__node->_prev, before = prev;
+            size_type used = 0, held = 0;   // batch[used, held): allocated, not built
+            try
+            {
+                while (count > 0)
+                {
+                    size_type n = count < __NODE_BATCH ? count : __NODE_BATCH;
+                    __alloc_traits::allocate_batch(__alloc, 1, n, batch);
+                    held = n;
+                    for (used = 0; used < n; ++used)
+                    {
+                        toy_std::construct(&batch[used]->_data, value);
+                        __link_after(prev, batch[used]);
+                        prev = batch[used];
+                        ++__size;
+                    }
+                    used = held = 0;
+                    count -= n;
+                }
+            }
+            catch (...)
+            {
+                __insert_rollback(pos, before, prev, batch, used, held);
+                throw;
+            }
+            __link_after(prev, pos.__node);
+            return iterator(before->_next);
+        }
+
+        /*
+            Same for a range of unknown length: batches start small and
+            double, the unused tail of the last batch is given back.
+        */
+        template<typename InputIt>
+        iterator __insert_range(iterator pos, InputIt first, InputIt last)
+        {
+            __tNode_Pointer batch[__NODE_BATCH];
+            __tNode_Pointer prev = pos.__node->_prev, before = prev;
+            size_type n = 8;
+            size_type used = 0, held = 0;   // batch[used, held): allocated, not built
+            try
+            {
+                while (first != last)
+                {
+                    __alloc_traits::allocate_batch(__alloc, 1, n, batch);
+                    held = n;
+                    for (used = 0; used < n && first != last; ++used, ++first)
+                    {
+                        toy_std::construct(&batch[used]->_data, *first);
+                        __link_after(prev, batch[used]);
+                        prev = batch[used];
+                        ++__size;
+                    }
+                    __alloc_traits::deallocate_batch(__alloc, 1, n - used, batch + used);
+                    used = held = 0;
+                    n = n < __NODE_BATCH ? n << 1 : __NODE_BATCH;
+                }
+            }
+            catch (...)
+            {
+                __insert_rollback(pos, before, prev, batch, used, held);
+                throw;
+            }
+            __link_after(prev, pos.__node);
+            return iterator(before->_next);
+        }
+
+        // Give back every node, the sentinel included.
+        void __release() noexcept
+        {
+            if (__Node != nullptr)
+            {
+                clear();
+                __alloc.deallocate(__Node, 1);
+                __Node = nullptr;
+            }
+        }
+
+        // A moved-from list has no sentinel until it is assigned to.
+        void __ensure_node()
+        {
+            if (__Node == nullptr)
+            {
+                __Node = __alloc.allocate(1);
+                __Node->_prev = __Node;
+                __Node->_next = __Node;
+            }
+        }
+
+        // Assign [first, last) into the nodes already held, then trim or extend.
+        template<typename InputIt>
+        void __assign_nodes(InputIt first, InputIt last)
+        {
+            __ensure_node();
+            __tNode_Pointer p = __Node->_next;
+            for (; p != __Node && first != last; p = p->_next, ++first)
+                p->_data = *first;
+            if (first == last)
+                erase(iterator(p), end());
+            else
+                __insert_range(end(), first, last);
+        }
+
+        // A moved-from list(no sentinel) gets one back; its only position is end().
+        iterator __valid_pos(iterator pos)
+        {
+            if (__Node != nullptr)
+                return pos;
+            __ensure_node();
+            return end();
+        }
+
+        void __copy_assign_alloc(const tlist<T, Allocator>& t, __true_type)
+        {
+            if (!__allocator_equal(__alloc, t.__alloc))
+                __release();
+            __alloc = t.__alloc;
+        }
+        void __copy_assign_alloc(const tlist<T, Allocator>&, __false_type) { }
+
+        void __steal_nodes(tlist<T, Allocator>& rt) noexcept
+        {
+            __release();
+            __Node = rt.__Node;
+            __size = rt.__size;
+            rt.__Node = nullptr;
+            rt.__size = 0;
+        }
+
+        void __move_assign(tlist<T, Allocator>& rt, __true_type)
+        {
+            __release();
+            __alloc = rt.__alloc;
+            __steal_nodes(rt);
+        }
+        void __move_assign(tlist<T, Allocator>& rt, __false_type)
         {
-            __size = (size_type)n;
-            __Node = __alloc.allocate(1);
-            // Can be replaced by the last 2 lines.
-            // __Node->_prev = __Node;
-            // __Node->_next = __Node;
-            auto tmp = __Node;
-            for (size_t i = 0; i < n; i++)
+            // Nodes may only change hands between equal allocators;
+            // otherwise the elements are moved into our own nodes.
+            if (__allocator_equal(__alloc, rt.__alloc))
+                __steal_nodes(rt);
+            else
             {
-                tmp->_next = __alloc.allocate(1);
-                tmp->_next->_prev = tmp;
-                tmp = tmp->_next;
-                tmp->_data = (value_type)value;
+                __assign_nodes(std::make_move_iterator(rt.begin()), std::make_move_iterator(rt.end()));
+                rt.clear();
             }
+        }
+
+        void __swap_alloc(tlist<T, Allocator>& t, __true_type) { toy_std::swap(__alloc, t.__alloc); }
+        void __swap_alloc(tlist<T, Allocator>&, __false_type) { }
+
+        template<typename InputIt>
+        iterator __insert_dispatch(iterator pos, InputIt first, InputIt last, __false_type)
+        {
+            return __insert_range(pos, first, last);
+        }
+
+        template<typename Integer>
+        iterator __insert_dispatch(iterator pos, Integer count, Integer value, __true_type)
+        {
+            return __insert_fill(pos, (size_type)count, (value_type)value);
+        }
+
+        /* Dispatch Constructor */
+        template<typename __Input>
+        void __tlist_construct_dispatch(__Input first, __Input last, __false_type)
+        {
+            __ensure_node();
+            __insert_range(end(), first, last);
+        }
 
-            __Node->_prev = tmp;
-            tmp->_next = __Node;
+        template<typename __Input>
+        void __tlist_construct_dispatch(__Input n, __Input value, __true_type)
+        {
+            __ensure_node();
+            __insert_fill(end(), (size_type)n, (value_type)value);
         }
 
     };
@@ -288,8 +601,9 @@ namespace toy_std
     void
     tlist<T, Allocator>::swap(tlist<T, Allocator>& t)
     {
+        // Without propagate_on_container_swap the allocators must be equal.
         toy_std::swap(this->__Node, t.__Node);
-        toy_std::swap(this->__alloc, t.__alloc);
+        __swap_alloc(t, typename __alloc_traits::propagate_on_container_swap());
         toy_std::swap(this->__size, t.__size);
     }
 
@@ -303,7 +617,7 @@ namespace toy_std
         pos.__node->_prev->_next = pos.__node->_next;
         pos.__node->_next->_prev = pos.__node->_prev;
         __size--;
-        __alloc.deallocate(pos.__node, 1);
+        __destroy_node(pos.__node);
         return res;
     }
 
@@ -317,42 +631,42 @@ namespace toy_std
     }
 
     template<typename T, typename Allocator>
-    typename tlist<T, Allocator>::iterator 
+    inline typename tlist<T, Allocator>::iterator 
     tlist<T, Allocator>::insert(iterator pos, const value_type& value)
     {
-        __tNode_Pointer tmp = __alloc.allocate(1);
-        tmp->_data = value;
-        tmp->_next = pos.__node;
-        tmp->_prev = pos.__node->_prev;
-        pos.__node->_prev->_next = tmp;
-        pos.__node->_prev = tmp;
-        __size++;
+        return emplace(pos, value);
+    }
 
-        return --pos;
+    template<typename T, typename Allocator>
+    inline typename tlist<T, Allocator>::iterator
+    tlist<T, Allocator>::insert(iterator pos, value_type&& value)
+    {
+        return emplace(pos, std::move(value));
     }
 
     template<typename T, typename Allocator>
+    template<typename... Args>
     typename tlist<T, Allocator>::iterator
-    tlist<T, Allocator>::insert(iterator pos, value_type&& value)
+    tlist<T, Allocator>::emplace(iterator pos, Args&&... args)
     {
-        __tNode_Pointer tmp = __alloc.allocate(1);
-        tmp->_data = value;
+        pos = __valid_pos(pos);
+        __tNode_Pointer tmp = __create_node(std::forward<Args>(args)...);
         tmp->_next = pos.__node;
         tmp->_prev = pos.__node->_prev;
         pos.__node->_prev->_next = tmp;
         pos.__node->_prev = tmp;
         __size++;
 
-        return --pos;
+        return iterator(tmp);
     }
 
     template<typename T, typename Allocator>
     typename tlist<T, Allocator>::iterator
     tlist<T, Allocator>::insert(iterator pos, size_type count, const value_type& value)
     {
-        for (size_type i = 0; i < count; ++i)
-            pos = insert(pos, value);
-        return pos;
+        if (count == 0)
+            return pos;
+        return __insert_fill(__valid_pos(pos), count, value);
     }
 
     template<typename T, typename Allocator>
@@ -370,121 +684,133 @@ namespace toy_std
     {   
         if (first == last)
             return pos;
+        // insert(pos, 5, 3) lands here too: treat two integers as (count, value).
+        using is_int_type = typename __Is_Integral_type_traits<InputIt>::is_int;
+        return __insert_dispatch(__valid_pos(pos), first, last, is_int_type());
+    }
 
-        iterator res = insert(pos, *first);
-        first++;
-        while (first != last)
-        {
-            insert(pos, *first);
-            first++;
-        }
-
-        return res;
+    template<typename T, typename Allocator>
+    inline void
+    tlist<T, Allocator>::pop_front()
+    {
+        erase(begin());
     }
 
     template<typename T, typename Allocator>
-    void
-    tlist<T, Allocator>::push_back(value_type&& value)
-    {
-        __tNode_Pointer tmp = __alloc.allocate(1);
-        tmp->_data = value;
-        tmp->_next = __Node;
-        tmp->_prev = __Node->_prev;
-        __Node->_prev->_next = tmp;
-        __Node->_prev = tmp;
-        __size++;
+    inline void
+    tlist<T, Allocator>::pop_back()
+    {
+        erase(iterator(__Node->_prev));
     }
 
     template<typename T, typename Allocator>
-    void
-    tlist<T, Allocator>::push_front(value_type&& value)
-    {
-        __tNode_Pointer tmp = __alloc.allocate(1);
-        tmp->_data = value;
-        tmp->_prev = __Node;
-        tmp->_next = __Node->_next;
-        __Node->_next->_prev = tmp;
-        __Node->_next = tmp;
-        __size++;
+    inline void
+    tlist<T, Allocator>::clear() noexcept
+    {
+        if (__Node == nullptr)
+            return;
+        using trivial_dealloc = typename tallocator_traits<Allocator>::has_trivial_deallocate;
+        using trivial_dtor = typename __type_traits<T>::has_trivival_destructor;
+        __clear_aux(trivial_dealloc(), trivial_dtor());
     }
 
+    /*
+        Both lists sorted by 'comp'; stable(on ties ours come first).
+        Every run of 'other' that goes before '*p' is moved in one transfer.
+        If 'comp' throws, the nodes moved so far stay here and the sizes
+        are kept right.
+    */
     template<typename T, typename Allocator>
+    template<typename Compare>
     void
-    tlist<T, Allocator>::pop_front()
+    tlist<T, Allocator>::merge(tlist<T, Allocator>& other, Compare comp)
     {
-        auto tmp = __Node->_next;
-        __Node->_next->_next->_prev = __Node;
-        __Node->_next = __Node->_next->_next;
-        __alloc.deallocate(tmp, 1);
+        if (&other == this || other.__size == 0)
+            return;
+        __ensure_node();
 
+        size_type moved = 0;
+        try
+        {
+            __tNode_Pointer p = __Node->_next;
+            __tNode_Pointer q = other.__Node->_next;
+            while (p != __Node && q != other.__Node)
+            {
+                if (comp(q->_data, p->_data))
+                {
+                    __tNode_Pointer run_end = q->_next;
+                    size_type run = 1;
+                    while (run_end != other.__Node && comp(run_end->_data, p->_data))
+                    {
+                        run_end = run_end->_next;
+                        ++run;
+                    }
+                    __transfer(p, q, run_end);
+                    moved += run;
+                    q = run_end;
+                }
+                else
+                    p = p->_next;
+            }
+        }
+        catch (...)
+        {
+            __size += moved;
+            other.__size -= moved;
+            throw;
+        }
+        // What is left of 'other' goes after everything.
+        __transfer(__Node, other.__Node->_next, other.__Node);
+        __size += other.__size;
+        other.__size = 0;
     }
 
     template<typename T, typename Allocator>
     void
-    tlist<T, Allocator>::pop_back()
+    tlist<T, Allocator>::splice(iterator pos, tlist<T, Allocator>& other)
     {
-        auto tmp = __Node->_prev;
-        __Node->_prev->_prev->_next = __Node;
-        __Node->_prev = __Node->_prev->_prev;
-        __alloc.deallocate(tmp, 1);
+        if (&other == this || other.__size == 0)
+            return;
+        pos = __valid_pos(pos);
+        __transfer(pos.__node, other.__Node->_next, other.__Node);
+        __size += other.__size;
+        other.__size = 0;
     }
 
     template<typename T, typename Allocator>
-    inline void
-    tlist<T, Allocator>::clear() noexcept
+    void
+    tlist<T, Allocator>::splice(iterator pos, tlist<T, Allocator>& other, iterator it)
     {
-        erase(begin(), end());
+        pos = __valid_pos(pos);
+        __tNode_Pointer next = it.__node->_next;
+        if (pos.__node == it.__node || pos.__node == next)
+            return;
+        __transfer(pos.__node, it.__node, next);
+        ++__size;
+        --other.__size;
     }
 
     template<typename T, typename Allocator>
-    void tlist<T, Allocator>::merge(tlist<T, Allocator>&& t)
+    void
+    tlist<T, Allocator>::splice(iterator pos, tlist<T, Allocator>& other, iterator first, iterator last, size_type count)
     {
-        auto p_size = __size;
-        auto p = __Node->_next;
-        auto q = t.__Node;
-        while (p_size > 0 && t.__size > 0)
-        {
-            q = t.__Node->_next;
-            if (p->_data < q->_data)
-            {
-                q->_prev->_next = q->_next;
-                q->_next->_prev = q->_prev;
-
-                q->_prev = p->_prev;
-                q->_next = p;
-                p->_prev->_next = q;
-                p->_prev = q;
-
-
-                t.__size--;
-                __size++;
-            }
-            else
-            {
-                p_size--;
-                p = p->_next;
-            }
-                
-        }
-
-        if (t.__size > 0)
+        if (first == last)
+            return;
+        pos = __valid_pos(pos);
+        __transfer(pos.__node, first.__node, last.__node);
+        if (&other != this)
         {
-            __Node->_prev->_next = t.__Node->_next;
-            t.__Node->_next->_prev = __Node->_prev;
-            __Node->_prev = t.__Node->_prev;
-            t.__Node->_prev->_next = __Node;
-
-            t.__Node->_prev = t.__Node;
-            t.__Node->_next = t.__Node;
-            t.__size = 0;
+            __size += count;
+            other.__size -= count;
         }
-
     }
 
     template<typename T, typename Allocator>
     void
     tlist<T, Allocator>::reverse() noexcept
     {
+        if (__Node == nullptr)
+            return;
         auto tmp = __Node->_next;
         while (tmp != __Node)
         {
@@ -499,7 +825,7 @@ namespace toy_std
     void
     tlist<T, Allocator>::remove(const value_type& value)
     {
-        auto tmp = iterator(__Node->_next);
+        auto tmp = begin();
         while (tmp != end())
         {
             if (*tmp == value)
@@ -513,36 +839,124 @@ namespace toy_std
     void
     tlist<T, Allocator>::unique()
     {
-        auto tmp = iterator(__Node->_next);
-        value_type _now_value = *(tmp++);
-        while (tmp != end())
+        if (__size < 2)
+            return;
+        // Compare each element with the last one kept; never read end().
+        auto kept = begin();
+        auto tmp = kept;
+        while (++tmp != end())
         {
-            if (*tmp != _now_value)
+            if (*tmp == *kept)
+                tmp = --erase(tmp);
+            else
+                kept = tmp;
+        }
+    }
+
+    /*
+        b = merge(a, b). Stable: on ties the node from 'a'(the earlier run)
+        goes first. If 'comp' throws, 'b' still chains every node: the
+        merged part, then what is left of 'a', then what is left of 'b'.
+    */
+    template<typename T, typename Allocator>
+    template<typename Compare>
+    void
+    tlist<T, Allocator>::__merge_runs(__tNode_Pointer a, __tNode_Pointer& b, Compare& comp)
+    {
+        __tNode_Pointer head = nullptr;
+        __tNode_Pointer* tail = &head;
+        try
+        {
+            while (a != nullptr && b != nullptr)
             {
-                ++tmp;
-                _now_value = *tmp;
+                if (comp(b->_data, a->_data))
+                {
+                    *tail = b;
+                    b = b->_next;
+                }
+                else
+                {
+                    *tail = a;
+                    a = a->_next;
+                }
+                tail = &(*tail)->_next;
             }
-            else
-                tmp = erase(tmp);
         }
+        catch (...)
+        {
+            *tail = a;
+            while (*tail != nullptr)
+                tail = &(*tail)->_next;
+            *tail = b;
+            b = head;
+            throw;
+        }
+        *tail = a != nullptr ? a : b;
+        b = head;
     }
 
+    /*
+        Bottom-up merge sort over the nodes themselves: no element is
+        copied or moved, only '_next'/'_prev' change.
+
+        bins[i] holds a sorted run of 2^i nodes(or nothing). Each node
+        taken off the list is merged upwards like a binary counter
+        increment; the bins are then merged from the smallest up. Older
+        runs always sit on the left of a merge, which keeps the sort stable.
+    */
     template<typename T, typename Allocator>
+    template<typename Compare>
     void
-    tlist<T, Allocator>::sort()
+    tlist<T, Allocator>::sort(Compare comp)
     {
-        // Selection Sort
-        auto tmp = __Node->_next;
-        auto max_suffix = tmp;
-        while (tmp != __Node)
+        if (__size < 2)
+            return;
+
+        const size_type __MAX_BINS = 64;
+        // runs[0]: the carry, runs[1]: not sorted yet, runs[2 + i]: bins[i].
+        __tNode_Pointer runs[__MAX_BINS + 2] = { };
+        __tNode_Pointer* bins = runs + 2;
+        __tNode_Pointer& carry = runs[0];
+        __tNode_Pointer& rest = runs[1];
+        size_type top = 0;
+
+        __Node->_prev->_next = nullptr;
+        rest = __Node->_next;
+        try
         {
-            max_suffix = tmp;
-            for (auto suffix = tmp->_next; suffix != __Node; suffix = suffix->_next)
-                if (suffix->_data > max_suffix->_data)
-                    max_suffix = suffix;
-            toy_std::swap(tmp->_data, max_suffix->_data);
-            tmp = tmp->_next;
+            while (rest != nullptr)
+            {
+                carry = rest;
+                rest = rest->_next;
+                carry->_next = nullptr;
+
+                size_type i = 0;
+                for (; bins[i] != nullptr; ++i)
+                {
+                    __tNode_Pointer older = bins[i];
+                    bins[i] = nullptr;
+                    __merge_runs(older, carry, comp);
+                }
+                bins[i] = carry;
+                carry = nullptr;
+                if (i == top)
+                    ++top;
+            }
+            for (size_type i = 0; i < top; ++i)
+                if (bins[i] != nullptr)
+                {
+                    __tNode_Pointer older = bins[i];
+                    bins[i] = nullptr;
+                    __merge_runs(older, carry, comp);
+                }
         }
+        catch (...)
+        {
+            // Every node is still in exactly one chain; the order is unspecified.
+            __relink_runs(runs, __MAX_BINS + 2);
+            throw;
+        }
+        __relink_runs(runs, 1);
     }
 
     template<typename T, typename Allocator>
@@ -556,48 +970,29 @@ namespace toy_std
     }
 
     template<typename T, typename Allocator>
-    tlist<T, Allocator>::tlist(size_type n, const value_type& value):
-    __alloc(), __Node(nullptr), __size(n)
+    tlist<T, Allocator>::tlist(const Allocator& alloc):
+    __alloc(alloc), __Node(nullptr), __size(0)
     {
         __Node = __alloc.allocate(1);
-        // Can be replaced by the last 2 lines.
-        // __Node->_prev = __Node;
-        // __Node->_next = __Node;
-        auto tmp = __Node;
-        for (size_t i = 0; i < n; i++)
-        {
-            tmp->_next = __alloc.allocate(1);
-            tmp->_next->_prev = tmp;
-            tmp = tmp->_next;
-            tmp->_data = value;
-        }
+        __Node->_prev = __Node;
+        __Node->_next = __Node;
+    }
 
-        __Node->_prev = tmp;
-        tmp->_next = __Node;
+    template<typename T, typename Allocator>
+    tlist<T, Allocator>::tlist(size_type n, const value_type& value, const Allocator& alloc):
+    __alloc(alloc), __Node(nullptr), __size(0)
+    {
+        __ensure_node();
+        __insert_fill(end(), n, value);
     }
 
     template<typename T, typename Allocator>
     tlist<T, Allocator>::tlist(const tlist<T, Allocator>& t):
-    __alloc(), __Node(nullptr), __size(t.__size)
+    __alloc(__alloc_traits::select_on_container_copy_construction(t.__alloc)), __Node(nullptr), __size(0)
     {
-        __Node = __alloc.allocate(1);
-        // Can be replaced by the last 2 lines.
-        // __Node->_prev = __Node;
-        // __Node->_next = __Node;
-
-        auto tmp = __Node;
-        auto t_tmp = t.__Node;
-        while (t_tmp->_next != t.__Node)
-        {
-            tmp->_next = __alloc.allocate(1);
-            tmp->_next->_prev = tmp;
-            tmp = tmp->_next;
-            t_tmp = t_tmp->_next;
-            tmp->_data = t_tmp->_data;
-        }
-
-        __Node->_prev = tmp;
-        tmp->_next = __Node;
+        __ensure_node();
+        if (t.__Node != nullptr)
+            __insert_range(end(), iterator(t.__Node->_next), iterator(t.__Node));
     }
 
     template<typename T, typename Allocator>
@@ -605,7 +1000,6 @@ namespace toy_std
     __alloc(rt.__alloc), __Node(rt.__Node), __size(rt.__size)
     {
         rt.__Node = nullptr;
-        rt.__alloc = Allocator();
         rt.__size = 0;
     }
 
@@ -613,8 +1007,11 @@ namespace toy_std
     tlist<T, Allocator>&
     tlist<T, Allocator>::operator=(const tlist<T, Allocator>& t)
     {
-        tlist<T, Allocator> tmp(t);
-        swap(tmp);
+        if (this != &t)
+        {
+            __copy_assign_alloc(t, typename __alloc_traits::propagate_on_container_copy_assignment());
+            __assign_nodes(t.cbegin(), t.cend());
+        }
         return *this;
     }
 
@@ -623,24 +1020,15 @@ namespace toy_std
     tlist<T, Allocator>::operator=(tlist<T, Allocator>&& rt)
     {
         if (this != &rt)
-        {
-            clear();
-            __alloc = rt.__alloc;
-            __Node = rt.__Node;
-            __size = rt.__size;
-
-            rt.__Node = nullptr;
-            rt.__alloc = Allocator();
-            rt.__size = 0;
-        }
+            __move_assign(rt, typename __alloc_traits::propagate_on_container_move_assignment());
 
         return *this;
     }
 
     template<typename T, typename Allocator>
     template<typename InputIt>
-    tlist<T, Allocator>::tlist(InputIt first, InputIt last):
-    __alloc(), __Node(nullptr), __size(0)
+    tlist<T, Allocator>::tlist(InputIt first, InputIt last, const Allocator& alloc):
+    __alloc(alloc), __Node(nullptr), __size(0)
     {
         using is_int_type = typename __Is_Integral_type_traits<InputIt>::is_int;
         __tlist_construct_dispatch(first, last, is_int_type());
@@ -661,42 +1049,25 @@ namespace toy_std
     }
 
     template<typename T, typename Allocator>
-    tlist<T, Allocator>::tlist(initializer_list<value_type> ilist):
-    __alloc(), __Node(nullptr), __size(0)
+    tlist<T, Allocator>::tlist(initializer_list<value_type> ilist, const Allocator& alloc):
+    __alloc(alloc), __Node(nullptr), __size(0)
     {
-        __Node = __alloc.allocate(1);
-        auto t_tmp = ilist.begin();
-        auto t_tmp_end = ilist.end();
-        auto tmp = __Node;
-        while (t_tmp != t_tmp_end)
-        {
-            tmp->_next = __alloc.allocate(1);
-            tmp->_next->_prev = tmp;
-            tmp = tmp->_next;
-            tmp->_data = *t_tmp;
-            t_tmp++;
-            __size++;
-        }
-
-        __Node->_prev = tmp;
-        tmp->_next = __Node;
+        __ensure_node();
+        __insert_range(end(), ilist.begin(), ilist.end());
     }
 
 
+    // Through cbegin()/cend(): a moved-from list(no sentinel) compares as empty.
     template<typename T, typename Alloc>
     bool operator==(const tlist<T, Alloc>& lhs, const tlist<T, Alloc>& rhs)
     {
         if (lhs.__size != rhs.__size)
             return false;
 
-        auto ls = lhs.__Node->_next, rs = rhs.__Node->_next;
-        while (ls != lhs.__Node)
-        {
-            if (ls->_data != rs->_data)
+        auto ls = lhs.cbegin(), rs = rhs.cbegin();
+        for (; ls != lhs.cend(); ++ls, ++rs)
+            if (!(*ls == *rs))
                 return false;
-            ls = ls->_next;
-            rs = rs->_next;
-        }
 
         return true;
     }
@@ -711,20 +1082,16 @@ namespace toy_std
     template<typename T, typename Alloc>
     bool operator<(const tlist<T, Alloc>& lhs, const tlist<T, Alloc>& rhs)
     {
-        auto ls = lhs.__Node->_next, rs = rhs.__Node->_next;
-        while (ls != lhs.__Node && rs != rhs.__Node)
+        auto ls = lhs.cbegin(), rs = rhs.cbegin();
+        for (; ls != lhs.cend() && rs != rhs.cend(); ++ls, ++rs)
         {
-            if (ls->data < rs->data)
+            if (*ls < *rs)
                 return true;
-            else if (ls->data > rs->data)
+            else if (*rs < *ls)
                 return false;
-            ls = ls->_next;
-            rs = rs->_next;
         }
 
-        if (rs == rhs.__Node)
-            return false;
-        return true;
+        return ls == lhs.cend() && rs != rhs.cend();
     }
 
     template<typename T, typename Alloc>
@@ -737,20 +1104,16 @@ namespace toy_std
     template<typename T, typename Alloc>
     bool operator<=(const tlist<T, Alloc>& lhs, const tlist<T, Alloc>& rhs)
     {
-        auto ls = lhs.__Node->_next, rs = rhs.__Node->_next;
-        while (ls != lhs.__Node && rs != rhs.__Node)
+        auto ls = lhs.cbegin(), rs = rhs.cbegin();
+        for (; ls != lhs.cend() && rs != rhs.cend(); ++ls, ++rs)
         {
-            if (ls->data < rs->data)
+            if (*ls < *rs)
                 return true;
-            else if (ls->data > rs->data)
+            else if (*rs < *ls)
                 return false;
-            ls = ls->_next;
-            rs = rs->_next;
         }
 
-        if (ls == lhs.__Node)
-            return true;
-        return false;
+        return ls == lhs.cend();
     }
 
     template<typename T, typename Alloc>
@@ -0,0 +1,221 @@
+/*
+    Project:        Toy_MPMC_Queue
+    Description:    bounded multi-producer/multi-consumer queue(D. Vyukov's design)
+    Update date:    2026/10/17
+    Author:         Zhuofan Zhang
+
+    Model:
+
+        __cells:  | seq, T | seq, T | seq, T | ... |     (capacity() cells, a power of two)
+
+        Cell 'i' starts with seq = i. For a position 'pos' and its cell:
+
+            seq == pos          free:  a producer CASes __enqueue.pos to pos + 1,
+                                       builds T, then stores seq = pos + 1
+            seq == pos + 1      full:  a consumer CASes __dequeue.pos to pos + 1,
+                                       takes T, then stores seq = pos + capacity()
+            seq <  pos(+1)      the queue is full(empty) for this producer(consumer)
+            otherwise           another thread won the position: reload and retry
+
+        Each cell's sequence number hands the cell from producers to
+        consumers and back, so the two position counters are the only
+        shared writes; they sit on separate cache lines.
+
+        try_push/try_pop never wait. push/pop spin on the try variant and
+        yield the CPU between attempts once a short spin has failed.
+
+        A claimed cell cannot be given back to producers, so T's constructor
+        must not throw inside push/emplace.
+*/
+#pragma once
+#include"toy_std.hpp"
+#include"toymemory.hpp"
+#include<atomic>
+#include<cstdint>
+#include<thread>
+
+namespace toy_std
+{
+    template<typename T>
+    struct __mpmc_cell
+    {
+        std::atomic<size_t> seq;
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T* value() noexcept { return reinterpret_cast<T*>(storage); }
+    };
+
+    template<typename T,
+             typename Allocator = tallocator<T>>
+    class tmpmc_queue
+    {
+    public:
+        /* Member types */
+        using value_type = T;
+        using allocator_type = Allocator;
+        using size_type = size_t;
+        using reference = value_type&;
+        using const_reference = const value_type&;
+
+        /* Constructors */
+        // 'capacity' is rounded up to a power of two(at least 2).
+        explicit tmpmc_queue(size_type capacity, const Allocator& alloc = Allocator()) :
+        __cell_allocator(alloc), __mask(__round_capacity(capacity) - 1)
+        {
+            __cells = __cell_allocator.allocate(__mask + 1);
+            for (size_t i = 0; i <= __mask; ++i)
+                ::new((void*)&__cells[i].seq) std::atomic<size_t>(i);
+        }
+
+        tmpmc_queue(const tmpmc_queue&) = delete;
+        tmpmc_queue& operator=(const tmpmc_queue&) = delete;
+
+        /* Destructor */
+        // No thread may still be using the queue.
+        ~tmpmc_queue() noexcept
+        {
+            size_t head = __dequeue.pos.load(std::memory_order_relaxed);
+            size_t tail = __enqueue.pos.load(std::memory_order_relaxed);
+            for (; head != tail; ++head)
+                toy_std::destroy(__cells[head & __mask].value());
+            __cell_allocator.deallocate(__cells, __mask + 1);
+        }
+
+        allocator_type get_allocator() const { return allocator_type(__cell_allocator); }
+
+        /* Capacity */
+        size_type capacity() const noexcept { return __mask + 1; }
+        // A snapshot: may be stale as soon as it returns.
+        size_type size() const noexcept
+        {
+            size_t tail = __enqueue.pos.load(std::memory_order_acquire);
+            size_t head = __dequeue.pos.load(std::memory_order_acquire);
+            return tail > head ? tail - head : 0;
+        }
+        bool empty() const noexcept { return size() == 0; }
+
+        /* Non-blocking */
+        bool try_push(const value_type& value)
+        {
+            return __try_push([&](T* p) { toy_std::construct(p, value); });
+        }
+        bool try_push(value_type&& value)
+        {
+            return __try_push([&](T* p) { ::new((void*)p) T(std::move(value)); });
+        }
+        template<typename... Args>
+        bool try_emplace(Args&&... args)
+        {
+            return __try_push([&](T* p) { ::new((void*)p) T(std::forward<Args>(args)...); });
+        }
+
+        // false: the queue is empty, 'out' is untouched.
+        bool try_pop(value_type& out)
+        {
+            __mpmc_cell<T>* cell;
+            size_t pos = __dequeue.pos.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                cell = &__cells[pos & __mask];
+                size_t seq = cell->seq.load(std::memory_order_acquire);
+                intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+                if (diff == 0)
+                {
+                    if (__dequeue.pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (diff < 0)
+                    return false;
+                else
+                    pos = __dequeue.pos.load(std::memory_order_relaxed);
+            }
+            // The cell is ours now; a throwing move still hands it back.
+            T* p = cell->value();
+            try
+            {
+                out = std::move(*p);
+            }
+            catch (...)
+            {
+                toy_std::destroy(p);
+                cell->seq.store(pos + __mask + 1, std::memory_order_release);
+                throw;
+            }
+            toy_std::destroy(p);
+            cell->seq.store(pos + __mask + 1, std::memory_order_release);
+            return true;
+        }
+
+        /* Blocking */
+        void push(const value_type& value)
+        {
+            for (unsigned spins = 0; !try_push(value); ++spins)
+                __backoff(spins);
+        }
+        void push(value_type&& value)
+        {
+            // try_push(T&&) only moves from 'value' once it has a cell.
+            for (unsigned spins = 0; !try_push(std::move(value)); ++spins)
+                __backoff(spins);
+        }
+        void pop(value_type& out)
+        {
+            for (unsigned spins = 0; !try_pop(out); ++spins)
+                __backoff(spins);
+        }
+
+    private:
+        using cell_allocator_type = typename Allocator::template rebind<__mpmc_cell<T>>::other;
+
+        cell_allocator_type __cell_allocator;
+        __mpmc_cell<T>* __cells;
+        size_t __mask;
+
+        struct alignas(__CACHE_LINE) __position
+        {
+            std::atomic<size_t> pos{0};
+        };
+        __position __enqueue;
+        __position __dequeue;
+
+        static size_t __round_capacity(size_t n)
+        {
+            size_t c = 2;
+            while (c < n)
+                c <<= 1;
+            return c;
+        }
+
+        static void __backoff(unsigned spins)
+        {
+            if (spins >= 64)
+                std::this_thread::yield();
+        }
+
+        // 'build(p)' constructs the element once a free cell is claimed.
+        template<typename Build>
+        bool __try_push(Build build)
+        {
+            __mpmc_cell<T>* cell;
+            size_t pos = __enqueue.pos.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                cell = &__cells[pos & __mask];
+                size_t seq = cell->seq.load(std::memory_order_acquire);
+                intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+                if (diff == 0)
+                {
+                    if (__enqueue.pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (diff < 0)
+                    return false;
+                else
+                    pos = __enqueue.pos.load(std::memory_order_relaxed);
+            }
+            build(cell->value());
+            cell->seq.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+    };
+}
@@ -0,0 +1,469 @@
+/*
+    Project:        Toy_Small_Vector
+    Update date:    2026/10/17
+    Author:         Zhuofan Zhang
+
+    Model:
+
+        tsmall_vector<T, N>
+        | __start | __finish | __end_of_storage | __alloc | inline buffer: N x T |
+            |                                                ^
+            '------------------------------------------------'   size() <= N
+            |
+            '--> heap storage from 'Allocator'                    size() >  N
+
+        Up to N elements live in the object itself: no allocator traffic
+        at all for the common small case. Past N it grows like tvector
+        (doubling, memcpy relocation for POD types). shrink_to_fit() moves
+        back inline once the elements fit again.
+
+        Moving a vector that is still inline moves its elements one by one,
+        so unlike tvector a move is O(size()) (at most N).
+*/
+#pragma once
+#include"toy_std.hpp"
+#include"toymemory.hpp"
+#include"toyiterator.hpp"
+#include"toyalgo_base.hpp"
+#include<algorithm>
+#include<iterator>
+
+using std::initializer_list;
+
+namespace toy_std
+{
+    template<typename T,
+             size_t N,
+             typename Allocator = tallocator<T>>
+    class tsmall_vector
+    {
+        static_assert(N > 0, "tsmall_vector needs room for at least one inline element");
+
+    public:
+        /* Member types */
+        using value_type = T;
+        using allocator_type = Allocator;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = typename Allocator::pointer;
+        using const_pointer = typename Allocator::const_pointer;
+        using iterator = T*;
+        using const_iterator = const T*;
+        using reference = T&;
+        using const_reference = const T&;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+        static const size_type inline_capacity = N;
+
+        /* Constructors */
+        tsmall_vector() : tsmall_vector(Allocator()) { }
+        explicit tsmall_vector(const Allocator& alloc) :
+            __start(__inline_data()), __finish(__inline_data()), __end_of_storage(__inline_data() + N), __alloc(alloc) { }
+        tsmall_vector(size_type count, const value_type& value, const Allocator& alloc = Allocator()) :
+            tsmall_vector(alloc)
+        {
+            insert(end(), count, value);
+        }
+        template<typename InputIt>
+        tsmall_vector(InputIt first, InputIt last, const Allocator& alloc = Allocator()) :
+            tsmall_vector(alloc)
+        {
+            insert(end(), first, last);
+        }
+        tsmall_vector(initializer_list<value_type> ilist, const Allocator& alloc = Allocator()) :
+            tsmall_vector(alloc)
+        {
+            insert(end(), ilist.begin(), ilist.end());
+        }
+        tsmall_vector(const tsmall_vector& v) :
+            tsmall_vector(tallocator_traits<Allocator>::select_on_container_copy_construction(v.__alloc))
+        {
+            insert(end(), v.begin(), v.end());
+        }
+        tsmall_vector(tsmall_vector&& v) : tsmall_vector(v.__alloc)
+        {
+            __take(v);
+        }
+
+        tsmall_vector& operator=(const tsmall_vector& v)
+        {
+            if (this != &v)
+            {
+                __copy_assign_alloc(v, typename __alloc_traits::propagate_on_container_copy_assignment());
+                assign(v.begin(), v.end());
+            }
+            return *this;
+        }
+        tsmall_vector& operator=(tsmall_vector&& v)
+        {
+            if (this != &v)
+                __move_assign(v, typename __alloc_traits::propagate_on_container_move_assignment());
+            return *this;
+        }
+        tsmall_vector& operator=(initializer_list<value_type> ilist)
+        {
+            assign(ilist.begin(), ilist.end());
+            return *this;
+        }
+
+        /* Destructor */
+        ~tsmall_vector() noexcept
+        {
+            toy_std::destroy(__start, __finish);
+            __free_heap();
+        }
+
+        template<typename InputIt>
+        void assign(InputIt first, InputIt last)
+        {
+            clear();
+            insert(end(), first, last);
+        }
+        void assign(size_type count, const value_type& value)
+        {
+            clear();
+            insert(end(), count, value);
+        }
+
+        allocator_type get_allocator() const { return __alloc; }
+
+
+        /* Element Access */
+        reference operator[](size_type idx) { return __start[idx]; }
+        const_reference operator[](size_type idx) const { return __start[idx]; }
+        reference at(size_type idx)
+        {
+            return const_cast<reference>(static_cast<const tsmall_vector&>(*this).at(idx));
+        }
+        const_reference at(size_type idx) const
+        {
+            if (idx >= size())
+                throw std::range_error("RANGE_ERROR: the index must in range [0,size()).");
+            return __start[idx];
+        }
+        reference front() { return *__start; }
+        const_reference front() const { return *__start; }
+        reference back() { return *(__finish - 1); }
+        const_reference back() const { return *(__finish - 1); }
+        T* data() noexcept { return __start; }
+        const T* data() const noexcept { return __start; }
+
+
+        /* Iterators */
+        iterator begin() noexcept { return __start; }
+        const_iterator begin() const noexcept { return __start; }
+        const_iterator cbegin() const noexcept { return __start; }
+        iterator end() noexcept { return __finish; }
+        const_iterator end() const noexcept { return __finish; }
+        const_iterator cend() const noexcept { return __finish; }
+
+        reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+        const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(cend()); }
+        reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+        const_reverse_iterator crend() const noexcept { return const_reverse_iterator(cbegin()); }
+
+
+        /* Capacity */
+        bool empty() const noexcept { return __start == __finish; }
+        size_type size() const noexcept { return size_type(__finish - __start); }
+        size_type max_size() const noexcept { return __alloc.max_size(); }
+        size_type capacity() const noexcept { return size_type(__end_of_storage - __start); }
+        // Still in the inline buffer(no heap storage held)?
+        bool is_inline() const noexcept { return __start == __inline_data(); }
+
+        void reserve(size_type cap)
+        {
+            if (cap > capacity())
+                __reallocate(cap);
+        }
+
+        void shrink_to_fit()
+        {
+            if (is_inline() || __finish == __end_of_storage)
+                return;
+            if (size() <= N)
+                __move_inline();
+            else
+                __reallocate(size());
+        }
+
+
+        /* Modifiers */
+        void clear() noexcept
+        {
+            toy_std::destroy(__start, __finish);
+            __finish = __start;
+        }
+
+        template<typename... Args>
+        reference emplace_back(Args&&... args)
+        {
+            if (__finish == __end_of_storage)
+                return __emplace_back_grow(std::forward<Args>(args)...);
+            ::new((void*)__finish) T(std::forward<Args>(args)...);
+            return *__finish++;
+        }
+        void push_back(const value_type& value) { emplace_back(value); }
+        void push_back(value_type&& value) { emplace_back(std::move(value)); }
+        void pop_back()
+        {
+            --__finish;
+            toy_std::destroy(__finish);
+        }
+
+        template<typename... Args>
+        iterator emplace(const_iterator pos, Args&&... args)
+        {
+            size_type off = pos - __start;
+            emplace_back(std::forward<Args>(args)...);
+            std::rotate(__start + off, __finish - 1, __finish);
+            return __start + off;
+        }
+        iterator insert(const_iterator pos, const value_type& value) { return emplace(pos, value); }
+        iterator insert(const_iterator pos, value_type&& value) { return emplace(pos, std::move(value)); }
+
+        iterator insert(const_iterator pos, size_type count, const value_type& value)
+        {
+            size_type off = pos - __start, old = size();
+            value_type copy(value);     // 'value' may be one of ours
+            if (old + count > capacity())
+                __reallocate(toy_std::max(2 * capacity(), old + count));
+            try
+            {
+                for (size_type i = 0; i < count; ++i, ++__finish)
+                    ::new((void*)__finish) T(copy);
+            }
+            catch (...)
+            {
+                __pop_back_to(old);
+                throw;
+            }
+            std::rotate(__start + off, __start + old, __finish);
+            return __start + off;
+        }
+
+        // Append at the back, then rotate the new elements into place.
+        template<typename InputIt>
+        iterator insert(const_iterator pos, InputIt first, InputIt last)
+        {
+            using is_int_type = typename __Is_Integral_type_traits<InputIt>::is_int;
+            return __insert_dispatch(pos, first, last, is_int_type());
+        }
+        iterator insert(const_iterator pos, initializer_list<value_type> ilist)
+        {
+            return insert(pos, ilist.begin(), ilist.end());
+        }
+
+        iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            T* p = const_cast<T*>(first);
+            T* new_finish = std::move(const_cast<T*>(last), __finish, p);
+            toy_std::destroy(new_finish, __finish);
+            __finish = new_finish;
+            return p;
+        }
+
+        void resize(size_type count) { resize(count, value_type()); }
+        void resize(size_type count, const value_type& value)
+        {
+            if (count < size())
+                erase(__start + count, __finish);
+            else
+                insert(__finish, count - size(), value);
+        }
+
+        // Inline elements can't change hands: swap through moves.
+        void swap(tsmall_vector& v)
+        {
+            using propagate = typename __alloc_traits::propagate_on_container_swap;
+            tsmall_vector tmp(std::move(v));
+            v.__move_assign(*this, propagate());
+            __move_assign(tmp, propagate());
+        }
+
+    protected:
+        T* __start;
+        T* __finish;
+        T* __end_of_storage;
+        Allocator __alloc;
+        alignas(T) unsigned char __buffer[N * sizeof(T)];
+
+        /* Allocator propagation(see tallocator_traits) */
+        using __alloc_traits = tallocator_traits<Allocator>;
+
+        T* __inline_data() noexcept { return reinterpret_cast<T*>(__buffer); }
+        const T* __inline_data() const noexcept { return reinterpret_cast<const T*>(__buffer); }
+
+        void __free_heap() noexcept
+        {
+            if (!is_inline())
+                __alloc.deallocate(__start, capacity());
+        }
+
+        // Drop every element and the heap buffer: back to the inline storage.
+        void __release() noexcept
+        {
+            clear();
+            __free_heap();
+            __start = __finish = __inline_data();
+            __end_of_storage = __inline_data() + N;
+        }
+
+        void __copy_assign_alloc(const tsmall_vector& v, __true_type)
+        {
+            if (!__allocator_equal(__alloc, v.__alloc))
+                __release();
+            __alloc = v.__alloc;
+        }
+        void __copy_assign_alloc(const tsmall_vector&, __false_type) { }
+
+        void __move_assign(tsmall_vector& v, __true_type)
+        {
+            __release();
+            __alloc = v.__alloc;
+            __take(v);
+        }
+        void __move_assign(tsmall_vector& v, __false_type)
+        {
+            clear();
+            __take(v);
+        }
+
+        // An insert failed halfway: drop what it appended.
+        void __pop_back_to(size_type count) noexcept
+        {
+            toy_std::destroy(__start + count, __finish);
+            __finish = __start + count;
+        }
+
+        // Capacity becomes exactly 'cap'(> N) on the heap.
+        void __reallocate(size_type cap)
+        {
+            T* new_start = __alloc.allocate(cap);
+            T* new_finish;
+            try
+            {
+                new_finish = __uninitialized_relocate(__start, __finish, new_start);
+            }
+            catch (...)
+            {
+                __alloc.deallocate(new_start, cap);
+                throw;
+            }
+            __free_heap();
+            __start = new_start;
+            __finish = new_finish;
+            __end_of_storage = new_start + cap;
+        }
+
+        void __move_inline()
+        {
+            T* old = __start;
+            size_type cap = capacity();
+            __finish = __uninitialized_relocate(__start, __finish, __inline_data());
+            __start = __inline_data();
+            __end_of_storage = __inline_data() + N;
+            __alloc.deallocate(old, cap);
+        }
+
+        // Out of room: build the element first, 'args' may point into *this.
+        template<typename... Args>
+        reference __emplace_back_grow(Args&&... args)
+        {
+            size_type cap = capacity() * 2;
+            T* new_start = __alloc.allocate(cap);
+            T* slot = new_start + size();
+            try
+            {
+                ::new((void*)slot) T(std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                __alloc.deallocate(new_start, cap);
+                throw;
+            }
+            try
+            {
+                __uninitialized_relocate(__start, __finish, new_start);
+            }
+            catch (...)
+            {
+                toy_std::destroy(slot);
+                __alloc.deallocate(new_start, cap);
+                throw;
+            }
+            __free_heap();
+            __start = new_start;
+            __finish = slot + 1;
+            __end_of_storage = new_start + cap;
+            return *slot;
+        }
+
+        /*
+            Move v's elements into *this(empty): heap storage changes hands
+            when the allocators agree, inline elements are moved over.
+        */
+        void __take(tsmall_vector& v)
+        {
+            if (!v.is_inline() && __allocator_equal(__alloc, v.__alloc))
+            {
+                __free_heap();
+                __start = v.__start;
+                __finish = v.__finish;
+                __end_of_storage = v.__end_of_storage;
+                v.__start = v.__finish = v.__inline_data();
+                v.__end_of_storage = v.__inline_data() + N;
+                return;
+            }
+            reserve(v.size());
+            for (T* p = v.__start; p != v.__finish; ++p, ++__finish)
+                ::new((void*)__finish) T(std::move(*p));
+            v.clear();
+        }
+
+        template<typename InputIt>
+        iterator __insert_dispatch(const_iterator pos, InputIt first, InputIt last, __false_type)
+        {
+            size_type off = pos - __start, old = size();
+            try
+            {
+                for (; first != last; ++first)
+                    emplace_back(*first);
+            }
+            catch (...)
+            {
+                __pop_back_to(old);
+                throw;
+            }
+            std::rotate(__start + off, __start + old, __finish);
+            return __start + off;
+        }
+        template<typename Integer>
+        iterator __insert_dispatch(const_iterator pos, Integer count, Integer value, __true_type)
+        {
+            return insert(pos, (size_type)count, (value_type)value);
+        }
+    };
+
+    template<typename T, size_t N, typename Allocator>
+    bool operator==(const tsmall_vector<T, N, Allocator>& a, const tsmall_vector<T, N, Allocator>& b)
+    {
+        if (a.size() != b.size())
+            return false;
+        for (std::size_t i = 0; i < a.size(); ++i)
+            if (!(a[i] == b[i]))
+                return false;
+        return true;
+    }
+
+    template<typename T, size_t N, typename Allocator>
+    inline bool operator!=(const tsmall_vector<T, N, Allocator>& a, const tsmall_vector<T, N, Allocator>& b)
+    {
+        return !(a == b);
+    }
+
+    template<typename T, size_t N, typename Allocator>
+    inline void swap(tsmall_vector<T, N, Allocator>& a, tsmall_vector<T, N, Allocator>& b) { a.swap(b); }
+}
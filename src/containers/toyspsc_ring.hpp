@@ -0,0 +1,195 @@
+/*
+    Project:        Toy_SPSC_Ring
+    Description:    bounded lock-free single-producer/single-consumer ring
+    Update date:    2026/10/17
+    Author:         Zhuofan Zhang
+
+    Model:
+
+        __buffer:  | . | a | b | c | . | . | . | . |     (Capacity slots, a power of two)
+                         ^           ^
+                       head         tail
+                   (consumer)    (producer)
+
+        'head' and 'tail' only grow; a slot is 'index & (Capacity - 1)'.
+        size = tail - head, full when size == Capacity.
+
+        The producer alone writes 'tail' and the consumer alone writes 'head'.
+        Each index sits on its own cache line, next to the owner's cached
+        copy of the other side's index: the other line is only read again
+        when the cached copy says full(producer) or empty(consumer), so in
+        steady state the two sides do not bounce a line between them.
+
+        Exactly one producer thread and one consumer thread; any number of
+        rings per thread. size()/empty() are a snapshot.
+*/
+#pragma once
+#include"toy_std.hpp"
+#include"toymemory.hpp"
+#include<atomic>
+#include<iterator>
+
+namespace toy_std
+{
+    template<typename T,
+             size_t Capacity,
+             typename Allocator = tallocator<T>>
+    class tspsc_ring
+    {
+        static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                      "tspsc_ring: Capacity must be a power of two");
+
+    public:
+        /* Member types */
+        using value_type = T;
+        using allocator_type = Allocator;
+        using size_type = size_t;
+        using reference = value_type&;
+        using const_reference = const value_type&;
+
+        /* Constructors */
+        explicit tspsc_ring(const Allocator& alloc = Allocator()) :
+        __alloc(alloc), __buffer(__alloc.allocate(Capacity))
+        { }
+
+        tspsc_ring(const tspsc_ring&) = delete;
+        tspsc_ring& operator=(const tspsc_ring&) = delete;
+
+        /* Destructor */
+        // No thread may still be using the ring.
+        ~tspsc_ring() noexcept
+        {
+            size_t head = __consumer.head.load(std::memory_order_relaxed);
+            size_t tail = __producer.tail.load(std::memory_order_relaxed);
+            for (; head != tail; ++head)
+                toy_std::destroy(__slot(head));
+            __alloc.deallocate(__buffer, Capacity);
+        }
+
+        allocator_type get_allocator() const { return __alloc; }
+
+        /* Capacity */
+        static constexpr size_type capacity() noexcept { return Capacity; }
+        size_type size() const noexcept
+        {
+            size_t head = __consumer.head.load(std::memory_order_acquire);
+            size_t tail = __producer.tail.load(std::memory_order_acquire);
+            return tail - head;
+        }
+        bool empty() const noexcept { return size() == 0; }
+
+        /* Producer side */
+        bool try_push(const value_type& value) { return try_emplace(value); }
+        bool try_push(value_type&& value) { return try_emplace(std::move(value)); }
+
+        // false: the ring is full, nothing was built.
+        template<typename... Args>
+        bool try_emplace(Args&&... args)
+        {
+            size_t tail = __producer.tail.load(std::memory_order_relaxed);
+            if (tail - __producer.head_cache == Capacity)
+            {
+                __producer.head_cache = __consumer.head.load(std::memory_order_acquire);
+                if (tail - __producer.head_cache == Capacity)
+                    return false;
+            }
+            ::new((void*)__slot(tail)) T(std::forward<Args>(args)...);
+            __producer.tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        /*
+            Copies up to 'count' elements from 'first' in at most two
+            uninitialized_copy calls(the wrap point), then publishes them
+            with a single store. Returns how many went in.
+            T's copy constructor must not throw here.
+        */
+        template<typename ForwardIt>
+        size_type push_batch(ForwardIt first, size_type count)
+        {
+            size_t tail = __producer.tail.load(std::memory_order_relaxed);
+            size_t room = Capacity - (tail - __producer.head_cache);
+            if (room < count)
+            {
+                __producer.head_cache = __consumer.head.load(std::memory_order_acquire);
+                room = Capacity - (tail - __producer.head_cache);
+            }
+            size_type n = count < room ? count : room;
+            if (n == 0)
+                return 0;
+
+            size_t index = tail & __MASK;
+            size_type first_part = n < Capacity - index ? n : Capacity - index;
+            ForwardIt middle = std::next(first, first_part);
+            toy_std::uninitialized_copy(first, middle, __buffer + index);
+            if (first_part != n)
+                toy_std::uninitialized_copy(middle, std::next(middle, n - first_part), __buffer);
+
+            __producer.tail.store(tail + n, std::memory_order_release);
+            return n;
+        }
+
+        /* Consumer side */
+        // false: the ring is empty, 'out' is untouched.
+        bool try_pop(value_type& out)
+        {
+            size_t head = __consumer.head.load(std::memory_order_relaxed);
+            if (head == __consumer.tail_cache)
+            {
+                __consumer.tail_cache = __producer.tail.load(std::memory_order_acquire);
+                if (head == __consumer.tail_cache)
+                    return false;
+            }
+            T* p = __slot(head);
+            out = std::move(*p);
+            toy_std::destroy(p);
+            __consumer.head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Moves up to 'count' elements into 'out', frees their slots with a single store.
+        template<typename OutputIt>
+        size_type pop_batch(OutputIt out, size_type count)
+        {
+            size_t head = __consumer.head.load(std::memory_order_relaxed);
+            size_t avail = __consumer.tail_cache - head;
+            if (avail < count)
+            {
+                __consumer.tail_cache = __producer.tail.load(std::memory_order_acquire);
+                avail = __consumer.tail_cache - head;
+            }
+            size_type n = count < avail ? count : avail;
+            for (size_type i = 0; i < n; ++i, ++out)
+            {
+                T* p = __slot(head + i);
+                *out = std::move(*p);
+                toy_std::destroy(p);
+            }
+            if (n != 0)
+                __consumer.head.store(head + n, std::memory_order_release);
+            return n;
+        }
+
+    private:
+        static const size_t __MASK = Capacity - 1;
+
+        T* __slot(size_t index) const noexcept { return __buffer + (index & __MASK); }
+
+        Allocator __alloc;
+        T* __buffer;
+
+        // Written by the producer; 'head_cache' is its last look at __consumer.head.
+        struct alignas(__CACHE_LINE) __producer_line
+        {
+            std::atomic<size_t> tail{0};
+            size_t head_cache = 0;
+        } __producer;
+
+        // Written by the consumer; 'tail_cache' is its last look at __producer.tail.
+        struct alignas(__CACHE_LINE) __consumer_line
+        {
+            std::atomic<size_t> head{0};
+            size_t tail_cache = 0;
+        } __consumer;
+    };
+}
@@ -0,0 +1,707 @@
+/*
+    Project:        Toy_Unrolled_List
+    Description:    doubly-linked list of small arrays(several elements per node)
+    Update date:    2026/10/17
+    Author:         Zhuofan Zhang
+
+    Model:
+
+        __head <--> | prev | next | count | e0 e1 e2 . . | <--> | ... | e0 e1 . . . | <--> __head
+                                            (NodeCapacity slots, [0, count) live)
+
+        Like tlist there is a sentinel(__head, count 0) closing the ring.
+        An iterator holds its node and a [cur, last) pointer pair into the
+        node's elements(like the deque iterator), so a scan is a pointer
+        bump per element and follows a link once per node, instead of
+        once per element.
+
+        insert/emplace at an iterator moves at most NodeCapacity elements:
+            - room in the node: shift the tail of the node right by one;
+            - full node, inserting at its front: use the previous node's
+              free slot, or hang a new node before it;
+            - otherwise split the node in two halves first.
+        erase shifts the node's tail left; an emptied node is freed and a
+        node that drops to a quarter full is merged with its successor if
+        both fit in half a node, so traversal stays dense.
+
+        Insertion and erasure invalidate iterators into the node(s) they
+        touch; iterators into other nodes stay valid.
+*/
+#pragma once
+#include"toy_std.hpp"
+#include"toymemory.hpp"
+#include"toyiterator.hpp"
+#include"toyalgo_base.hpp"
+#include"toy_stl_function.hpp"
+#include"toyvector.hpp"
+#include<algorithm>
+#include<iterator>
+
+using std::initializer_list;
+
+namespace toy_std
+{
+    inline constexpr size_t
+    __unrolled_node_capacity(size_t n, size_t sz)
+    {
+        // About 256 bytes of elements per node, at least 4 of them.
+        return n != 0 ? n : (sz <= 64 ? size_t(256 / sz) : size_t(4));
+    }
+
+    /* Links and count: the sentinel is only this part */
+    struct __unrolled_node_base
+    {
+        __unrolled_node_base* _prev;
+        __unrolled_node_base* _next;
+        size_t _count;
+    };
+
+    template<typename T, size_t Capacity>
+    struct __unrolled_node : public __unrolled_node_base
+    {
+        alignas(T) unsigned char _storage[Capacity * sizeof(T)];
+
+        T* _data() noexcept { return reinterpret_cast<T*>(_storage); }
+    };
+
+    /*
+        Where a node's elements start, from its links alone. For the
+        sentinel this is a past-the-links address that is never read;
+        iterators only compare it.
+    */
+    template<typename T>
+    inline T* __unrolled_data(__unrolled_node_base* p) noexcept
+    {
+        const size_t offset = (sizeof(__unrolled_node_base) + alignof(T) - 1) & ~(alignof(T) - 1);
+        return reinterpret_cast<T*>(reinterpret_cast<char*>(p) + offset);
+    }
+
+    /* Unrolled list iterator: Bidirection Iterator */
+    template<typename T,
+             size_t Capacity,
+             typename Pointer = T*,
+             typename Reference = T&,
+             typename Distance = ptrdiff_t>
+    class __Unrolled_Iterator
+    {
+    public:
+        using __Self = __Unrolled_Iterator<T, Capacity, Pointer, Reference>;
+        using iterator = __Unrolled_Iterator<T, Capacity, T*, T&>;
+        using __node_type = __unrolled_node<T, Capacity>;
+
+        using iterator_category = bidirection_iterator_tag;
+        using value_type = T;
+        using pointer = Pointer;
+        using reference = Reference;
+        using difference_type = Distance;
+        using size_type = size_t;
+
+        /* Constructors */
+        __Unrolled_Iterator() : __cur(nullptr), __last(nullptr), __node(nullptr) { }
+        __Unrolled_Iterator(__unrolled_node_base* node, size_t index)
+        {
+            set_node(node);
+            __cur += index;
+        }
+        // iterator -> const_iterator(the copy constructor of iterator itself)
+        __Unrolled_Iterator(const iterator& x) : __cur(x.__cur), __last(x.__last), __node(x.__node) { }
+        __Unrolled_Iterator& operator=(const __Unrolled_Iterator&) = default;
+
+        /* Operators */
+        reference operator*() const { return *__cur; }
+        pointer operator->() const { return __cur; }
+
+        __Self& operator++()
+        {
+            if (++__cur == __last)
+                set_node(__node->_next);
+            return *this;
+        }
+        __Self operator++(int) { __Self tmp = *this; ++*this; return tmp; }
+        __Self& operator--()
+        {
+            if (__cur == __unrolled_data<T>(__node))
+            {
+                set_node(__node->_prev);
+                __cur = __last;
+            }
+            --__cur;
+            return *this;
+        }
+        __Self operator--(int) { __Self tmp = *this; --*this; return tmp; }
+
+        bool operator==(const __Self& b) const { return __cur == b.__cur; }
+        bool operator!=(const __Self& b) const { return !(*this == b); }
+
+        // Position inside the node.
+        size_t __index() const { return size_t(__cur - __unrolled_data<T>(__node)); }
+
+        // Jump to the first element of 'node'.
+        void set_node(__unrolled_node_base* node)
+        {
+            __node = node;
+            __cur = __unrolled_data<T>(node);
+            __last = __cur + node->_count;
+        }
+
+        T* __cur;                       // Current element
+        T* __last;                      // End of the node's live elements
+        __unrolled_node_base* __node;
+    };
+
+    /* tUnrolled_list */
+    template<typename T,
+             size_t NodeCapacity = 0,
+             typename Allocator = tallocator<T>>
+    class tunrolled_list
+    {
+        static const size_t __CAP = __unrolled_node_capacity(NodeCapacity, sizeof(T));
+        static_assert(__CAP >= 2, "tunrolled_list: a node must hold at least 2 elements");
+
+    public:
+        /* Member types */
+        using value_type = T;
+        using allocator_type = Allocator;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = value_type&;
+        using const_reference = const value_type&;
+        using pointer = value_type*;
+        using const_pointer = const value_type*;
+        using iterator = __Unrolled_Iterator<T, __CAP>;
+        using const_iterator = __Unrolled_Iterator<T, __CAP, const T*, const T&>;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+        /* Constructors */
+        tunrolled_list() : tunrolled_list(Allocator()) { }
+        explicit tunrolled_list(const Allocator& alloc) : __size(0), __alloc(alloc)
+        {
+            __reset_head();
+        }
+        tunrolled_list(size_type count, const value_type& value, const Allocator& alloc = Allocator()) :
+        tunrolled_list(alloc)
+        {
+            insert(end(), count, value);
+        }
+        template<typename InputIt>
+        tunrolled_list(InputIt first, InputIt last, const Allocator& alloc = Allocator()) :
+        tunrolled_list(alloc)
+        {
+            insert(end(), first, last);
+        }
+        tunrolled_list(initializer_list<value_type> ilist, const Allocator& alloc = Allocator()) :
+        tunrolled_list(alloc)
+        {
+            insert(end(), ilist.begin(), ilist.end());
+        }
+        tunrolled_list(const tunrolled_list& other) :
+        tunrolled_list(__alloc_traits::select_on_container_copy_construction(other.__alloc))
+        {
+            insert(end(), other.begin(), other.end());
+        }
+        tunrolled_list(tunrolled_list&& other) noexcept : tunrolled_list(other.__alloc)
+        {
+            __steal(other);
+        }
+
+        tunrolled_list& operator=(const tunrolled_list& other)
+        {
+            if (this != &other)
+            {
+                __copy_assign_alloc(other, typename __alloc_traits::propagate_on_container_copy_assignment());
+                assign(other.begin(), other.end());
+            }
+            return *this;
+        }
+        tunrolled_list& operator=(tunrolled_list&& other)
+        {
+            if (this != &other)
+                __move_assign(other, typename __alloc_traits::propagate_on_container_move_assignment());
+            return *this;
+        }
+        tunrolled_list& operator=(initializer_list<value_type> ilist)
+        {
+            assign(ilist.begin(), ilist.end());
+            return *this;
+        }
+
+        /* Destructor */
+        ~tunrolled_list() noexcept { clear(); }
+
+        template<typename InputIt>
+        void assign(InputIt first, InputIt last)
+        {
+            clear();
+            insert(end(), first, last);
+        }
+        void assign(size_type count, const value_type& value)
+        {
+            clear();
+            insert(end(), count, value);
+        }
+
+        allocator_type get_allocator() const { return __alloc; }
+
+        /* Capacity */
+        bool empty() const noexcept { return __size == 0; }
+        size_type size() const noexcept { return __size; }
+        size_type max_size() const noexcept { return __alloc.max_size(); }
+        static constexpr size_type node_capacity() noexcept { return __CAP; }
+
+        /* Element Access */
+        reference front() { return *begin(); }
+        const_reference front() const { return *begin(); }
+        reference back() { return *--end(); }
+        const_reference back() const { return *--end(); }
+
+        /* Iterators */
+        iterator begin() noexcept { return iterator(__head._next, 0); }
+        iterator end() noexcept { return iterator(&__head, 0); }
+        const_iterator begin() const noexcept { return const_iterator(__head._next, 0); }
+        const_iterator end() const noexcept { return const_iterator(const_cast<__unrolled_node_base*>(&__head), 0); }
+        const_iterator cbegin() const noexcept { return begin(); }
+        const_iterator cend() const noexcept { return end(); }
+
+        reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+        reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+        const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(end()); }
+        const_reverse_iterator crend() const noexcept { return const_reverse_iterator(begin()); }
+
+        /* Modifiers */
+        void clear() noexcept
+        {
+            for (__unrolled_node_base* p = __head._next; p != &__head; )
+            {
+                __node_type* n = static_cast<__node_type*>(p);
+                p = p->_next;
+                toy_std::destroy(n->_data(), n->_data() + n->_count);
+                __node_allocator.deallocate(n, 1);
+            }
+            __reset_head();
+        }
+
+        template<typename... Args>
+        iterator emplace(const_iterator pos, Args&&... args)
+        {
+            return __emplace_at(pos.__node, pos.__index(), std::forward<Args>(args)...);
+        }
+        iterator insert(const_iterator pos, const value_type& value) { return emplace(pos, value); }
+        iterator insert(const_iterator pos, value_type&& value) { return emplace(pos, std::move(value)); }
+        iterator insert(const_iterator pos, size_type count, const value_type& value)
+        {
+            value_type copy(value);     // 'value' may be one of ours
+            iterator it(pos.__node, pos.__index());
+            if (count == 0)
+                return it;
+            for (size_type i = 0; i < count; ++i, ++it)
+                it = __emplace_at(it.__node, it.__index(), copy);
+            return __back_to_first(it, count);
+        }
+        template<typename InputIt>
+        iterator insert(const_iterator pos, InputIt first, InputIt last)
+        {
+            using is_int_type = typename __Is_Integral_type_traits<InputIt>::is_int;
+            return __insert_dispatch(pos, first, last, is_int_type());
+        }
+        iterator insert(const_iterator pos, initializer_list<value_type> ilist)
+        {
+            return insert(pos, ilist.begin(), ilist.end());
+        }
+
+        iterator erase(const_iterator pos);
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            // Nodes shift and merge under us: erase by count, not up to 'last'.
+            size_type count = 0;
+            for (const_iterator it = first; it != last; ++it)
+                ++count;
+            iterator res(first.__node, first.__index());
+            for (; count > 0; --count)
+                res = erase(res);
+            return res;
+        }
+
+        void push_back(const value_type& value) { emplace_back(value); }
+        void push_back(value_type&& value) { emplace_back(std::move(value)); }
+        void push_front(const value_type& value) { emplace_front(value); }
+        void push_front(value_type&& value) { emplace_front(std::move(value)); }
+        template<typename... Args>
+        reference emplace_back(Args&&... args) { return *__emplace_at(&__head, 0, std::forward<Args>(args)...); }
+        template<typename... Args>
+        reference emplace_front(Args&&... args) { return *__emplace_at(__head._next, 0, std::forward<Args>(args)...); }
+        void pop_back() { erase(--end()); }
+        void pop_front() { erase(begin()); }
+
+        void resize(size_type count) { resize(count, value_type()); }
+        void resize(size_type count, const value_type& value)
+        {
+            if (count < __size)
+            {
+                while (__size > count)
+                    pop_back();
+            }
+            else
+                insert(end(), count - __size, value);
+        }
+
+        void swap(tunrolled_list& other)
+        {
+            // Sentinels live inside the lists: move the chains through a third one.
+            tunrolled_list tmp(__alloc);
+            tmp.__steal(*this);
+            __steal(other);
+            other.__steal(tmp);
+            __swap_alloc(other, typename __alloc_traits::propagate_on_container_swap());
+        }
+
+        /* Operations */
+        void remove(const value_type& value)
+        {
+            value_type copy(value);     // 'value' may be one of ours
+            __compact([&](const value_type& x, const value_type*) { return !(x == copy); });
+        }
+        template<typename UnaryPredicate>
+        void remove_if(UnaryPredicate pred)
+        {
+            __compact([&](const value_type& x, const value_type*) { return !pred(x); });
+        }
+        void unique()
+        {
+            __compact([](const value_type& x, const value_type* kept) { return kept == nullptr || !(x == *kept); });
+        }
+        void reverse() noexcept;
+        void sort() { sort(less<T>()); }
+        // Stable: elements are moved out, sorted and moved back, the nodes keep their shape.
+        template<typename Compare>
+        void sort(Compare comp)
+        {
+            if (__size < 2)
+                return;
+            tvector<value_type, Allocator> buffer(__alloc);
+            buffer.reserve(__size);
+            for (iterator it = begin(); it != end(); ++it)
+                buffer.push_back(std::move(*it));
+            std::stable_sort(buffer.begin(), buffer.end(), comp);
+            auto src = buffer.begin();
+            for (iterator it = begin(); it != end(); ++it, ++src)
+                *it = std::move(*src);
+        }
+
+    protected:
+        using __node_type = __unrolled_node<T, __CAP>;
+        using __alloc_traits = tallocator_traits<Allocator>;
+        using node_allocator_type = typename Allocator::template rebind<__node_type>::other;
+
+        __unrolled_node_base __head;
+        size_type __size;
+        Allocator __alloc;
+        node_allocator_type __node_allocator{__alloc};
+
+        static __node_type* __as_node(__unrolled_node_base* p) noexcept { return static_cast<__node_type*>(p); }
+
+        void __reset_head() noexcept
+        {
+            __head._prev = &__head;
+            __head._next = &__head;
+            __head._count = 0;
+            __size = 0;
+        }
+
+        // Take over other's nodes; *this must be empty.
+        void __steal(tunrolled_list& other) noexcept
+        {
+            if (other.__size == 0)
+                return;
+            __head._next = other.__head._next;
+            __head._prev = other.__head._prev;
+            __head._next->_prev = &__head;
+            __head._prev->_next = &__head;
+            __size = other.__size;
+            other.__reset_head();
+        }
+
+        void __copy_assign_alloc(const tunrolled_list& other, __true_type)
+        {
+            if (!__allocator_equal(__alloc, other.__alloc))
+                clear();
+            __alloc = other.__alloc;
+            __node_allocator = other.__node_allocator;
+        }
+        void __copy_assign_alloc(const tunrolled_list&, __false_type) { }
+
+        void __move_assign(tunrolled_list& other, __true_type)
+        {
+            clear();
+            __alloc = other.__alloc;
+            __node_allocator = other.__node_allocator;
+            __steal(other);
+        }
+        void __move_assign(tunrolled_list& other, __false_type)
+        {
+            clear();
+            // Nodes may only change hands between equal allocators.
+            if (__allocator_equal(__alloc, other.__alloc))
+                __steal(other);
+            else
+            {
+                insert(end(), std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+                other.clear();
+            }
+        }
+
+        void __swap_alloc(tunrolled_list& other, __true_type)
+        {
+            toy_std::swap(__alloc, other.__alloc);
+            toy_std::swap(__node_allocator, other.__node_allocator);
+        }
+        void __swap_alloc(tunrolled_list&, __false_type) { }
+
+        // A fresh, empty node linked before 'pos'.
+        __node_type* __new_node_before(__unrolled_node_base* pos)
+        {
+            __node_type* n = __node_allocator.allocate(1);
+            n->_count = 0;
+            n->_next = pos;
+            n->_prev = pos->_prev;
+            pos->_prev->_next = n;
+            pos->_prev = n;
+            return n;
+        }
+
+        void __free_node(__node_type* n) noexcept
+        {
+            n->_prev->_next = n->_next;
+            n->_next->_prev = n->_prev;
+            __node_allocator.deallocate(n, 1);
+        }
+
+        /*
+            Build T(args...) at 'index' of 'n', which has a free slot.
+            The element is built before anything shifts, so a throwing
+            constructor leaves the node as it was.
+        */
+        template<typename... Args>
+        static void __put(__node_type* n, size_t index, Args&&... args)
+        {
+            T* data = n->_data();
+            size_t count = n->_count;
+            if (index == count)
+                ::new((void*)(data + count)) T(std::forward<Args>(args)...);
+            else
+            {
+                T value(std::forward<Args>(args)...);
+                ::new((void*)(data + count)) T(std::move(data[count - 1]));
+                try
+                {
+                    std::move_backward(data + index, data + count - 1, data + count);
+                    data[index] = std::move(value);
+                }
+                catch (...)
+                {
+                    // Not counted yet: don't leak the extra slot.
+                    toy_std::destroy(data + count);
+                    throw;
+                }
+            }
+            ++n->_count;
+        }
+
+        template<typename... Args>
+        iterator __emplace_at(__unrolled_node_base* pos, size_t index, Args&&... args);
+
+        // Move the upper half of 'n' into a new node after it.
+        __node_type* __split(__node_type* n)
+        {
+            __node_type* m = __new_node_before(n->_next);
+            size_t keep = n->_count / 2;
+            __uninitialized_relocate(n->_data() + keep, n->_data() + n->_count, m->_data());
+            m->_count = n->_count - keep;
+            n->_count = keep;
+            return m;
+        }
+
+        /*
+            'it' is just past 'count' new elements: step back to the first.
+            (A split may have moved it, so the position is not kept.)
+        */
+        static iterator __back_to_first(iterator it, size_type count)
+        {
+            for (; count > 0; --count)
+                --it;
+            return it;
+        }
+
+        template<typename InputIt>
+        iterator __insert_dispatch(const_iterator pos, InputIt first, InputIt last, __false_type)
+        {
+            size_type count = 0;
+            iterator it(pos.__node, pos.__index());
+            for (; first != last; ++first, ++count, ++it)
+                it = __emplace_at(it.__node, it.__index(), *first);
+            return __back_to_first(it, count);
+        }
+
+        template<typename Integer>
+        iterator __insert_dispatch(const_iterator pos, Integer count, Integer value, __true_type)
+        {
+            return insert(pos, (size_type)count, (value_type)value);
+        }
+
+        /*
+            One pass keeping the elements with keep(x, last kept element):
+            survivors slide down inside their node, emptied nodes are freed
+            afterwards(the last kept element may live in one until then).
+        */
+        template<typename Keep>
+        void __compact(Keep keep);
+    };
+
+    template<typename T, size_t NodeCapacity, typename Allocator>
+    template<typename... Args>
+    typename tunrolled_list<T, NodeCapacity, Allocator>::iterator
+    tunrolled_list<T, NodeCapacity, Allocator>::__emplace_at(__unrolled_node_base* pos, size_t index, Args&&... args)
+    {
+        // 'index == 0' of a node: the end of the previous one is the same spot.
+        if (index == 0 && pos->_prev != &__head && pos->_prev->_count < __CAP)
+        {
+            __node_type* prev = __as_node(pos->_prev);
+            size_t at = prev->_count;
+            __put(prev, at, std::forward<Args>(args)...);
+            ++__size;
+            return iterator(prev, at);
+        }
+        if (pos == &__head || (index == 0 && pos->_count == __CAP))
+        {
+            __node_type* n = __new_node_before(pos);
+            try
+            {
+                __put(n, 0, std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                __free_node(n);
+                throw;
+            }
+            ++__size;
+            return iterator(n, 0);
+        }
+
+        __node_type* n = __as_node(pos);
+        if (n->_count == __CAP)
+        {
+            // 'args' may refer to an element the split is about to move.
+            T value(std::forward<Args>(args)...);
+            __node_type* m = __split(n);
+            if (index > n->_count)
+            {
+                index -= n->_count;
+                n = m;
+            }
+            __put(n, index, std::move(value));
+        }
+        else
+            __put(n, index, std::forward<Args>(args)...);
+        ++__size;
+        return iterator(n, index);
+    }
+
+    template<typename T, size_t NodeCapacity, typename Allocator>
+    typename tunrolled_list<T, NodeCapacity, Allocator>::iterator
+    tunrolled_list<T, NodeCapacity, Allocator>::erase(const_iterator pos)
+    {
+        __node_type* n = __as_node(pos.__node);
+        size_t index = pos.__index();
+        T* data = n->_data();
+
+        std::move(data + index + 1, data + n->_count, data + index);
+        toy_std::destroy(data + --n->_count);
+        --__size;
+
+        if (n->_count == 0)
+        {
+            __unrolled_node_base* next = n->_next;
+            __free_node(n);
+            return iterator(next, 0);
+        }
+        // Sparse: fold the next node in if both fit in half a node.
+        __unrolled_node_base* next = n->_next;
+        if (n->_count <= __CAP / 4 && next != &__head && n->_count + next->_count <= __CAP / 2)
+        {
+            __node_type* m = __as_node(next);
+            __uninitialized_relocate(m->_data(), m->_data() + m->_count, data + n->_count);
+            n->_count += m->_count;
+            __free_node(m);
+        }
+        if (index == n->_count)
+            return iterator(n->_next, 0);
+        return iterator(n, index);
+    }
+
+    template<typename T, size_t NodeCapacity, typename Allocator>
+    template<typename Keep>
+    void
+    tunrolled_list<T, NodeCapacity, Allocator>::__compact(Keep keep)
+    {
+        const value_type* kept = nullptr;
+        for (__unrolled_node_base* p = __head._next; p != &__head; p = p->_next)
+        {
+            T* data = __as_node(p)->_data();
+            size_t w = 0;
+            for (size_t r = 0; r < p->_count; ++r)
+            {
+                if (!keep(data[r], kept))
+                    continue;
+                if (w != r)
+                    data[w] = std::move(data[r]);
+                kept = data + w++;
+            }
+            toy_std::destroy(data + w, data + p->_count);
+            __size -= p->_count - w;
+            p->_count = w;
+        }
+        for (__unrolled_node_base* p = __head._next; p != &__head; )
+        {
+            __unrolled_node_base* next = p->_next;
+            if (p->_count == 0)
+                __free_node(__as_node(p));
+            p = next;
+        }
+    }
+
+    template<typename T, size_t NodeCapacity, typename Allocator>
+    void
+    tunrolled_list<T, NodeCapacity, Allocator>::reverse() noexcept
+    {
+        __unrolled_node_base* p = &__head;
+        do
+        {
+            toy_std::swap(p->_prev, p->_next);
+            if (p != &__head)
+                std::reverse(__as_node(p)->_data(), __as_node(p)->_data() + p->_count);
+            p = p->_prev;       // the old '_next'
+        } while (p != &__head);
+    }
+
+    /* Non-member functions */
+    template<typename T, size_t C, typename Allocator>
+    bool operator==(const tunrolled_list<T, C, Allocator>& a, const tunrolled_list<T, C, Allocator>& b)
+    {
+        if (a.size() != b.size())
+            return false;
+        auto q = b.begin();
+        for (auto p = a.begin(); p != a.end(); ++p, ++q)
+            if (!(*p == *q))
+                return false;
+        return true;
+    }
+
+    template<typename T, size_t C, typename Allocator>
+    inline bool operator!=(const tunrolled_list<T, C, Allocator>& a, const tunrolled_list<T, C, Allocator>& b)
+    {
+        return !(a == b);
+    }
+
+    template<typename T, size_t C, typename Allocator>
+    inline void swap(tunrolled_list<T, C, Allocator>& a, tunrolled_list<T, C, Allocator>& b) { a.swap(b); }
+}
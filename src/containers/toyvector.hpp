@@ -1,7 +1,32 @@
+/*
+	Project:        Toy_Vector
+	Update date:    2026/10/17
+	Author:         Zhuofan Zhang
+
+	Update Log:     2026/10/17 -- Implement tvector: geometric growth, reserve/shrink_to_fit,
+	                              emplace, move-aware reallocation.
+
+	Model:
+
+		__start                   __finish           __end_of_storage
+		   |                         |                      |
+		   | x | x | x | ...... | x |   raw capacity ...   |
+
+		Growth doubles the capacity(at least to what is needed), so n
+		push_back()s cost O(n) element moves in total. On reallocation the
+		elements are relocated: memcpy when __type_traits says T is POD,
+		otherwise move-construct(copy if the move may throw) and destroy,
+		which keeps push_back/emplace_back strongly exception-safe.
+*/
 #pragma once
 #include"toy_std.hpp"
 #include"toymemory.hpp"
 #include"toyiterator.hpp"
+#include"toyalgo_base.hpp"
+#include<iterator>
+#include<cstring>
+
+using std::initializer_list;
 
 namespace toy_std
 {
@@ -9,29 +34,789 @@ namespace toy_std
 			 typename Allocator = tallocator<T>>
 	class tvector
 	{
-	protected:
-
-
 	public:
 		/* Member Types */
 		using value_type = T;
 		using allocator_type = Allocator;
 		using size_type = std::size_t;
 		using difference_type = std::ptrdiff_t;
-		using pointer = Allocator::pointer;
-		using const_pointer = Allocator::const_pointer;
+		using pointer = typename Allocator::pointer;
+		using const_pointer = typename Allocator::const_pointer;
 		using iterator = T*;
 		using const_iterator = const T*;
 		using reference = T&;
 		using const_reference = const T&;
+		using reverse_iterator = std::reverse_iterator<iterator>;
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+
+		/* Constructors */
+		tvector() : __start(nullptr), __finish(nullptr), __end_of_storage(nullptr), __alloc() { }
+		explicit tvector(const Allocator& alloc) :
+			__start(nullptr), __finish(nullptr), __end_of_storage(nullptr), __alloc(alloc) { }
+		tvector(size_type count, const value_type& value, const Allocator& alloc = Allocator()) :
+			tvector(alloc)
+		{
+			__fill_init(count, value);
+		}
+		explicit tvector(size_type count, const Allocator& alloc = Allocator()) :
+			tvector(alloc)
+		{
+			__fill_init(count, value_type());
+		}
+		template<typename InputIt>
+		tvector(InputIt first, InputIt last, const Allocator& alloc = Allocator()) :
+			tvector(alloc)
+		{
+			// tvector<int>(5, 3) lands here too: treat two integers as (count, value).
+			using is_int_type = typename __Is_Integral_type_traits<InputIt>::is_int;
+			__range_init_dispatch(first, last, is_int_type());
+		}
+		tvector(initializer_list<value_type> ilist, const Allocator& alloc = Allocator()) :
+			tvector(alloc)
+		{
+			__range_init(ilist.begin(), ilist.end(), forward_iterator_tag());
+		}
+		tvector(const tvector& v) :
+			tvector(__alloc_traits::select_on_container_copy_construction(v.__alloc))
+		{
+			__range_init(v.__start, v.__finish, forward_iterator_tag());
+		}
+		tvector(tvector&& v) noexcept :
+			__start(v.__start), __finish(v.__finish), __end_of_storage(v.__end_of_storage), __alloc(v.__alloc)
+		{
+			v.__start = v.__finish = v.__end_of_storage = nullptr;
+		}
+
+		tvector& operator=(const tvector&);
+		tvector& operator=(tvector&&);
+		tvector& operator=(initializer_list<value_type> ilist)
+		{
+			assign(ilist.begin(), ilist.end());
+			return *this;
+		}
+
+		/* Destructor */
+		~tvector() noexcept { __release(); }
+
+		void assign(size_type, const value_type&);
+		template<typename InputIt>
+		void assign(InputIt first, InputIt last)
+		{
+			using is_int_type = typename __Is_Integral_type_traits<InputIt>::is_int;
+			__assign_dispatch(first, last, is_int_type());
+		}
+		void assign(initializer_list<value_type> ilist) { assign(ilist.begin(), ilist.end()); }
+
+		allocator_type get_allocator() const { return __alloc; }
+
+
+		/* Element Access */
+		reference at(size_type idx)
+		{
+			return const_cast<reference>(static_cast<const tvector&>(*this).at(idx));
+		}
+		const_reference at(size_type idx) const
+		{
+			if (idx >= size())
+				throw std::range_error("RANGE_ERROR: the index must in range [0,size()).");
+			return __start[idx];
+		}
+		reference operator[](size_type idx) { return __start[idx]; }
+		const_reference operator[](size_type idx) const { return __start[idx]; }
+		reference front() { return *__start; }
+		const_reference front() const { return *__start; }
+		reference back() { return *(__finish - 1); }
+		const_reference back() const { return *(__finish - 1); }
+		T* data() noexcept { return __start; }
+		const T* data() const noexcept { return __start; }
+
+
+		/* Iterators */
+		iterator begin() noexcept { return __start; }
+		const_iterator begin() const noexcept { return __start; }
+		const_iterator cbegin() const noexcept { return __start; }
+		iterator end() noexcept { return __finish; }
+		const_iterator end() const noexcept { return __finish; }
+		const_iterator cend() const noexcept { return __finish; }
+
+		reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+		const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(cend()); }
+		reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+		const_reverse_iterator crend() const noexcept { return const_reverse_iterator(cbegin()); }
+
+
+		/* Capacity */
+		bool empty() const noexcept { return __start == __finish; }
+		size_type size() const noexcept { return size_type(__finish - __start); }
+		size_type max_size() const noexcept { return __alloc.max_size(); }
+		size_type capacity() const noexcept { return size_type(__end_of_storage - __start); }
+		void reserve(size_type);
+		void shrink_to_fit();
+
+
+		/* Modifiers */
+		void clear() noexcept
+		{
+			toy_std::destroy(__start, __finish);
+			__finish = __start;
+		}
+
+		iterator insert(const_iterator pos, const value_type& value) { return emplace(pos, value); }
+		iterator insert(const_iterator pos, value_type&& value) { return emplace(pos, std::move(value)); }
+		iterator insert(const_iterator, size_type, const value_type&);
+		template<typename InputIt>
+		iterator insert(const_iterator pos, InputIt first, InputIt last)
+		{
+			using is_int_type = typename __Is_Integral_type_traits<InputIt>::is_int;
+			return __insert_dispatch(pos, first, last, is_int_type());
+		}
+		iterator insert(const_iterator pos, initializer_list<value_type> ilist)
+		{
+			return insert(pos, ilist.begin(), ilist.end());
+		}
+		template<typename... Args>
+		iterator emplace(const_iterator, Args&&...);
+
+		iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+		iterator erase(const_iterator, const_iterator);
+
+		void push_back(const value_type& value) { emplace_back(value); }
+		void push_back(value_type&& value) { emplace_back(std::move(value)); }
+		template<typename... Args>
+		reference emplace_back(Args&&... args)
+		{
+			if (__finish != __end_of_storage)
+			{
+				__construct(__finish, std::forward<Args>(args)...);
+				++__finish;
+			}
+			else
+				__realloc_insert(__finish, 1, [&](T* p) { __construct(p, std::forward<Args>(args)...); });
+			return *(__finish - 1);
+		}
+		void pop_back()
+		{
+			--__finish;
+			toy_std::destroy(__finish);
+		}
+
+		void resize(size_type count) { __resize(count, value_type()); }
+		void resize(size_type count, const value_type& value) { __resize(count, value); }
+
+		void swap(tvector&);
+
+	protected:
+		T* __start;
+		T* __finish;
+		T* __end_of_storage;
+		Allocator __alloc;
+
+		/* Allocator propagation(see tallocator_traits) */
+		using __alloc_traits = tallocator_traits<Allocator>;
+		using __is_POD = typename __type_traits<T>::is_POD_type;
+
+		template<typename... Args>
+		static void __construct(T* p, Args&&... args)
+		{
+			::new((void*)p) T(std::forward<Args>(args)...);
+		}
+
+		// At least 'need' elements, and at least double the current capacity.
+		size_type __grow_to(size_type need) const
+		{
+			size_type cap = capacity();
+			size_type next = cap == 0 ? 1 : 2 * cap;
+			if (next < need)
+				next = need;
+			if (next > max_size())
+			{
+				if (need > max_size())
+					throw std::length_error("tvector: requested size exceeds max_size()");
+				next = max_size();
+			}
+			return next;
+		}
+
+		void __release() noexcept
+		{
+			if (__start != nullptr)
+			{
+				toy_std::destroy(__start, __finish);
+				__alloc.deallocate(__start, capacity());
+				__start = __finish = __end_of_storage = nullptr;
+			}
+		}
+
+		// Capacity becomes exactly 'cap'(>= size()).
+		void __reallocate(size_type cap)
+		{
+			T* new_start = cap == 0 ? nullptr : __alloc.allocate(cap);
+			T* new_finish;
+			try
+			{
+				new_finish = __uninitialized_relocate(__start, __finish, new_start);
+			}
+			catch (...)
+			{
+				__alloc.deallocate(new_start, cap);
+				throw;
+			}
+			if (__start != nullptr)
+				__alloc.deallocate(__start, capacity());
+			__start = new_start;
+			__finish = new_finish;
+			__end_of_storage = new_start + cap;
+		}
+
+		/*
+			Out of capacity: build 'count' new elements with 'fill' straight
+			into the new storage at their final place, then relocate the old
+			ones around them. 'fill' may still read the old elements(e.g.
+			push_back(v[0])); if anything throws, *this is unchanged.
+		*/
+		template<typename Fill>
+		void __realloc_insert(T* pos, size_type count, Fill fill)
+		{
+			size_type cap = __grow_to(size() + count);
+			size_type off = pos - __start;
+			T* new_start = __alloc.allocate(cap);
+			T* new_finish = nullptr;
+			try
+			{
+				fill(new_start + off);
+				try
+				{
+					__uninitialized_relocate(__start, pos, new_start);
+					try
+					{
+						new_finish = __uninitialized_relocate(pos, __finish, new_start + off + count);
+					}
+					catch (...)
+					{
+						// Moving the tail failed: bring the head back(POD never throws).
+						__uninitialized_relocate(new_start, new_start + off, __start);
+						throw;
+					}
+				}
+				catch (...)
+				{
+					toy_std::destroy(new_start + off, new_start + off + count);
+					throw;
+				}
+			}
+			catch (...)
+			{
+				__alloc.deallocate(new_start, cap);
+				throw;
+			}
+			if (__start != nullptr)
+				__alloc.deallocate(__start, capacity());
+			__start = new_start;
+			__finish = new_finish;
+			__end_of_storage = new_start + cap;
+		}
+
+		/*
+			Room for 'count' more elements at 'pos', capacity permitting.
+			Slots of the gap below the old end still hold(moved-from)
+			elements, those past it are raw: fill them with __put_at(), and
+			on a throw hand the gap to __close_gap(). Only the basic guarantee.
+		*/
+		void __open_gap(T* pos, size_type count, __true_type) noexcept
+		{
+			memmove((void*)(pos + count), (const void*)pos, (__finish - pos) * sizeof(T));
+			__finish += count;
+		}
+
+		void __open_gap(T* pos, size_type count, __false_type)
+		{
+			T* old_finish = __finish;
+			T* built = old_finish + count;		// lowest slot constructed past the old end
+			try
+			{
+				for (T* src = old_finish; src != pos; )
+				{
+					--src;
+					T* dst = src + count;
+					if (dst >= old_finish)
+					{
+						__construct(dst, std::move(*src));
+						built = dst;
+					}
+					else
+						*dst = std::move(*src);
+				}
+			}
+			catch (...)
+			{
+				toy_std::destroy(built, old_finish + count);
+				throw;
+			}
+			__finish += count;
+		}
 
-		// Wait for implement:
-		// using reverse_iterator = ;
-		// using const_reverse_iterator = ;
+		/*
+			A fill of the gap threw with [pos, filled) done: move the tail
+			back down over the gap and destroy what is left past it. Live
+			slots are those below max(old_finish, filled) and the tail from
+			pos + count on. Should a move throw here too, the vector simply
+			ends where the moves stopped.
+		*/
+		void __close_gap(T* pos, size_type count, T* old_finish, T* filled) noexcept
+		{
+			T* gap_end = pos + count;
+			T* live = filled > old_finish ? filled : old_finish;
+			if (live > gap_end)
+				live = gap_end;
+			T* dst = pos;
+			try
+			{
+				for (T* src = gap_end; src != __finish; ++src, ++dst)
+				{
+					if (dst < live || dst >= gap_end)
+						*dst = std::move(*src);
+					else
+					{
+						__construct(dst, std::move(*src));
+						live = dst + 1;
+					}
+				}
+			}
+			catch (...) { }
+			if (live > dst)
+				toy_std::destroy(dst, live);
+			toy_std::destroy(gap_end > dst ? gap_end : dst, __finish);
+			__finish = dst;
+		}
 
+		// After __open_gap(): assign a live slot, construct a raw one.
+		template<typename U>
+		void __put_at(T* p, T* old_finish, U&& value)
+		{
+			if (p < old_finish)
+				*p = std::forward<U>(value);
+			else
+				__construct(p, std::forward<U>(value));
+		}
 
-		/* Member Functions */
+		void __fill_init(size_type count, const value_type& value)
+		{
+			if (count == 0)
+				return;
+			__start = __alloc.allocate(count);
+			__finish = __start;
+			__end_of_storage = __start + count;
+			try
+			{
+				for (; __finish != __end_of_storage; ++__finish)
+					__construct(__finish, value);
+			}
+			catch (...)
+			{
+				__release();
+				throw;
+			}
+		}
 
+		/* Ranges: single pass for input iterators, sized up front otherwise */
+		template<typename InputIt>
+		static size_type __range_size(InputIt first, InputIt last)
+		{
+			size_type n = 0;
+			for (; first != last; ++first)
+				++n;
+			return n;
+		}
+		static size_type __range_size(const T* first, const T* last) { return last - first; }
+		static size_type __range_size(T* first, T* last) { return last - first; }
 
+		template<typename InputIt>
+		void __range_init(InputIt first, InputIt last, input_iterator_tag)
+		{
+			for (; first != last; ++first)
+				emplace_back(*first);
+		}
+		template<typename ForwardIt>
+		void __range_init(ForwardIt first, ForwardIt last, forward_iterator_tag)
+		{
+			size_type count = __range_size(first, last);
+			if (count == 0)
+				return;
+			__start = __alloc.allocate(count);
+			__finish = __start;
+			__end_of_storage = __start + count;
+			try
+			{
+				for (; first != last; ++first, ++__finish)
+					__construct(__finish, *first);
+			}
+			catch (...)
+			{
+				__release();
+				throw;
+			}
+		}
+		template<typename It>
+		void __range_init(It first, It last, std::input_iterator_tag) { __range_init(first, last, input_iterator_tag()); }
+		template<typename It>
+		void __range_init(It first, It last, std::forward_iterator_tag) { __range_init(first, last, forward_iterator_tag()); }
+
+		template<typename InputIt>
+		void __range_init_dispatch(InputIt first, InputIt last, __false_type)
+		{
+			__range_init(first, last, toy_std::__iterator_category(first));
+		}
+		template<typename Integer>
+		void __range_init_dispatch(Integer count, Integer value, __true_type)
+		{
+			__fill_init((size_type)count, (value_type)value);
+		}
+
+		template<typename InputIt>
+		iterator __insert_range(const_iterator pos, InputIt first, InputIt last, input_iterator_tag)
+		{
+			size_type off = pos - __start;
+			for (T* p = __start + off; first != last; ++first, ++p)
+				p = emplace(p, *first);
+			return __start + off;
+		}
+		template<typename ForwardIt>
+		iterator __insert_range(const_iterator cpos, ForwardIt first, ForwardIt last, forward_iterator_tag)
+		{
+			T* pos = const_cast<T*>(cpos);
+			size_type count = __range_size(first, last);
+			if (count == 0)
+				return pos;
+			if (size_type(__end_of_storage - __finish) < count)
+			{
+				size_type off = pos - __start;
+				__realloc_insert(pos, count, [&](T* p)
+				{
+					T* cur = p;
+					try
+					{
+						for (ForwardIt it = first; it != last; ++it, ++cur)
+							__construct(cur, *it);
+					}
+					catch (...)
+					{
+						toy_std::destroy(p, cur);
+						throw;
+					}
+				});
+				return __start + off;
+			}
+			T* old_finish = __finish;
+			__open_gap(pos, count, __is_POD());
+			T* p = pos;
+			try
+			{
+				for (; first != last; ++first, ++p)
+					__put_at(p, old_finish, *first);
+			}
+			catch (...)
+			{
+				__close_gap(pos, count, old_finish, p);
+				throw;
+			}
+			return pos;
+		}
+		template<typename It>
+		iterator __insert_range(const_iterator pos, It first, It last, std::input_iterator_tag)
+		{
+			return __insert_range(pos, first, last, input_iterator_tag());
+		}
+		template<typename It>
+		iterator __insert_range(const_iterator pos, It first, It last, std::forward_iterator_tag)
+		{
+			return __insert_range(pos, first, last, forward_iterator_tag());
+		}
+
+		template<typename InputIt>
+		iterator __insert_dispatch(const_iterator pos, InputIt first, InputIt last, __false_type)
+		{
+			return __insert_range(pos, first, last, toy_std::__iterator_category(first));
+		}
+		template<typename Integer>
+		iterator __insert_dispatch(const_iterator pos, Integer count, Integer value, __true_type)
+		{
+			return insert(pos, (size_type)count, (value_type)value);
+		}
+
+		template<typename InputIt>
+		void __assign_dispatch(InputIt first, InputIt last, __false_type)
+		{
+			// Reuse the live elements, then trim or append the rest.
+			T* p = __start;
+			for (; p != __finish && first != last; ++p, ++first)
+				*p = *first;
+			if (first == last)
+				erase(p, __finish);
+			else
+				__insert_range(__finish, first, last, toy_std::__iterator_category(first));
+		}
+		template<typename Integer>
+		void __assign_dispatch(Integer count, Integer value, __true_type)
+		{
+			assign((size_type)count, (value_type)value);
+		}
+
+		void __resize(size_type count, const value_type& value)
+		{
+			if (count < size())
+				erase(__start + count, __finish);
+			else if (count > size())
+				insert(__finish, count - size(), value);
+		}
+
+		void __copy_assign_alloc(const tvector& v, __true_type)
+		{
+			if (!__allocator_equal(__alloc, v.__alloc))
+				__release();
+			__alloc = v.__alloc;
+		}
+		void __copy_assign_alloc(const tvector&, __false_type) { }
+
+		void __steal(tvector& v) noexcept
+		{
+			__start = v.__start;
+			__finish = v.__finish;
+			__end_of_storage = v.__end_of_storage;
+			v.__start = v.__finish = v.__end_of_storage = nullptr;
+		}
+
+		void __move_assign(tvector& v, __true_type)
+		{
+			__release();
+			__alloc = v.__alloc;
+			__steal(v);
+		}
+		void __move_assign(tvector& v, __false_type)
+		{
+			// Storage may only change hands between equal allocators.
+			if (__allocator_equal(__alloc, v.__alloc))
+			{
+				__release();
+				__steal(v);
+			}
+			else
+			{
+				assign(std::make_move_iterator(v.begin()), std::make_move_iterator(v.end()));
+				v.clear();
+			}
+		}
+
+		void __swap_alloc(tvector& v, __true_type) { toy_std::swap(__alloc, v.__alloc); }
+		void __swap_alloc(tvector&, __false_type) { }
 	};
-}
\ No newline at end of file
+
+	template<typename T, typename Allocator>
+	tvector<T, Allocator>&
+	tvector<T, Allocator>::operator=(const tvector<T, Allocator>& v)
+	{
+		if (this != &v)
+		{
+			__copy_assign_alloc(v, typename __alloc_traits::propagate_on_container_copy_assignment());
+			assign(v.__start, v.__finish);
+		}
+		return *this;
+	}
+
+	template<typename T, typename Allocator>
+	tvector<T, Allocator>&
+	tvector<T, Allocator>::operator=(tvector<T, Allocator>&& v)
+	{
+		if (this != &v)
+			__move_assign(v, typename __alloc_traits::propagate_on_container_move_assignment());
+		return *this;
+	}
+
+	template<typename T, typename Allocator>
+	void
+	tvector<T, Allocator>::assign(size_type count, const value_type& value)
+	{
+		if (count > capacity())
+		{
+			// Nothing worth keeping: build the new storage from scratch.
+			tvector tmp(count, value, __alloc);
+			__release();
+			__steal(tmp);
+			return;
+		}
+		T* p = __start;
+		for (; p != __finish && count > 0; ++p, --count)
+			*p = value;
+		if (count == 0)
+			erase(p, __finish);
+		else
+			insert(__finish, count, value);
+	}
+
+	template<typename T, typename Allocator>
+	void
+	tvector<T, Allocator>::reserve(size_type cap)
+	{
+		if (cap > max_size())
+			throw std::length_error("tvector: reserve() exceeds max_size()");
+		if (cap > capacity())
+			__reallocate(cap);
+	}
+
+	template<typename T, typename Allocator>
+	void
+	tvector<T, Allocator>::shrink_to_fit()
+	{
+		if (__finish != __end_of_storage)
+			__reallocate(size());
+	}
+
+	template<typename T, typename Allocator>
+	typename tvector<T, Allocator>::iterator
+	tvector<T, Allocator>::insert(const_iterator cpos, size_type count, const value_type& value)
+	{
+		T* pos = const_cast<T*>(cpos);
+		if (count == 0)
+			return pos;
+		if (size_type(__end_of_storage - __finish) < count)
+		{
+			size_type off = pos - __start;
+			__realloc_insert(pos, count, [&](T* p)
+			{
+				T* cur = p;
+				try
+				{
+					for (size_type i = 0; i < count; ++i, ++cur)
+						__construct(cur, value);
+				}
+				catch (...)
+				{
+					toy_std::destroy(p, cur);
+					throw;
+				}
+			});
+			return __start + off;
+		}
+		// 'value' may live in the part about to move.
+		value_type copy(value);
+		T* old_finish = __finish;
+		__open_gap(pos, count, __is_POD());
+		T* p = pos;
+		try
+		{
+			for (; p != pos + count; ++p)
+				__put_at(p, old_finish, copy);
+		}
+		catch (...)
+		{
+			__close_gap(pos, count, old_finish, p);
+			throw;
+		}
+		return pos;
+	}
+
+	template<typename T, typename Allocator>
+	template<typename... Args>
+	typename tvector<T, Allocator>::iterator
+	tvector<T, Allocator>::emplace(const_iterator cpos, Args&&... args)
+	{
+		T* pos = const_cast<T*>(cpos);
+		if (pos == __finish)
+		{
+			emplace_back(std::forward<Args>(args)...);
+			return __finish - 1;
+		}
+		if (__finish == __end_of_storage)
+		{
+			size_type off = pos - __start;
+			__realloc_insert(pos, 1, [&](T* p) { __construct(p, std::forward<Args>(args)...); });
+			return __start + off;
+		}
+		// Build it first: 'args' may refer to elements about to move.
+		value_type tmp(std::forward<Args>(args)...);
+		T* old_finish = __finish;
+		__open_gap(pos, 1, __is_POD());
+		try
+		{
+			__put_at(pos, old_finish, std::move(tmp));
+		}
+		catch (...)
+		{
+			__close_gap(pos, 1, old_finish, pos);
+			throw;
+		}
+		return pos;
+	}
+
+	template<typename T, typename Allocator>
+	typename tvector<T, Allocator>::iterator
+	tvector<T, Allocator>::erase(const_iterator cfirst, const_iterator clast)
+	{
+		T* first = const_cast<T*>(cfirst);
+		T* last = const_cast<T*>(clast);
+		if (first == last)
+			return first;
+		T* new_finish = first;
+		for (T* p = last; p != __finish; ++p, ++new_finish)
+			*new_finish = std::move(*p);
+		toy_std::destroy(new_finish, __finish);
+		__finish = new_finish;
+		return first;
+	}
+
+	template<typename T, typename Allocator>
+	void
+	tvector<T, Allocator>::swap(tvector<T, Allocator>& v)
+	{
+		// Without propagate_on_container_swap the allocators must be equal.
+		toy_std::swap(__start, v.__start);
+		toy_std::swap(__finish, v.__finish);
+		toy_std::swap(__end_of_storage, v.__end_of_storage);
+		__swap_alloc(v, typename __alloc_traits::propagate_on_container_swap());
+	}
+
+
+	/* Non-member functions */
+	template<typename T, typename Allocator>
+	bool operator==(const tvector<T, Allocator>& a, const tvector<T, Allocator>& b)
+	{
+		if (a.size() != b.size())
+			return false;
+		for (std::size_t i = 0; i < a.size(); ++i)
+			if (!(a[i] == b[i]))
+				return false;
+		return true;
+	}
+
+	template<typename T, typename Allocator>
+	inline bool operator!=(const tvector<T, Allocator>& a, const tvector<T, Allocator>& b)
+	{
+		return !(a == b);
+	}
+
+	template<typename T, typename Allocator>
+	bool operator<(const tvector<T, Allocator>& a, const tvector<T, Allocator>& b)
+	{
+		std::size_t n = a.size() < b.size() ? a.size() : b.size();
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			if (a[i] < b[i])
+				return true;
+			if (b[i] < a[i])
+				return false;
+		}
+		return a.size() < b.size();
+	}
+
+	template<typename T, typename Allocator>
+	inline bool operator>(const tvector<T, Allocator>& a, const tvector<T, Allocator>& b) { return b < a; }
+
+	template<typename T, typename Allocator>
+	inline bool operator<=(const tvector<T, Allocator>& a, const tvector<T, Allocator>& b) { return !(b < a); }
+
+	template<typename T, typename Allocator>
+	inline bool operator>=(const tvector<T, Allocator>& a, const tvector<T, Allocator>& b) { return !(a < b); }
+
+	template<typename T, typename Allocator>
+	inline void swap(tvector<T, Allocator>& a, tvector<T, Allocator>& b) { a.swap(b); }
+}
@@ -1,14 +1,34 @@
 /*
     Project:        Toy_STL_Alloc
-    Update date:    2020/3/2
+    Update date:    2026/10/17
     Author:         Zhuofan Zhang
 
     Update Log:     2019/12/03 -- Add 'allocate/deallocate/refill' of the sub-allocator
                     2020/03/02 -- Change the alloc(s) into template mode.
+                    2026/10/17 -- Guard the sub-allocator with a pool lock; add the batch
+                                  transfer used by the thread caches(toy_stl_thread_alloc.hpp).
+                    2026/10/17 -- Add the lock-free instance(__lockfree_alloc).
+                    2026/10/17 -- Template the sub-allocator on a size-class policy(__size_classes).
+                    2026/10/17 -- Keep chunk headers; trim()/set_trim_threshold() release empty chunks.
+                    2026/10/17 -- Optional statistics(__TOY_ALLOC_STATS): stats()/dump_stats().
+                    2026/10/17 -- Pluggable chunk sources: __malloc_chunk_source(default), __mmap_chunk_source.
+                    2026/10/17 -- Per-class natural alignment; allocate_aligned/deallocate_aligned.
+                    2026/10/17 -- Public batch interface: allocate_batch/deallocate_batch.
+                    2026/10/17 -- Prioritized reclaim callbacks on the oom path; pools trim themselves.
 */
 #pragma once
 #include "toy_std.hpp"
+#include "toytype_traits.hpp"
 #include <new>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <cstdlib>
+#include <cstdint>
+#include <cstddef>
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#endif
 
 namespace toy_std
 {
@@ -17,22 +37,74 @@ namespace toy_std
     {
     private:
         /* oom: Out of memory */
-        static void* oom_malloc(size_t n)
+        static void* oom_malloc(size_t n, size_t align = 0)
         {
             void (*my_malloc_handler)();
             void* result;
 
+            // Shed caches first(see register_reclaim), then the SGI handler.
+            result = reclaim_and_retry([n, align]() { return align == 0 ? malloc(n) : __aligned_malloc(n, align); });
+            if (result)
+                return result;
+
             while (true)
             {
                 my_malloc_handler = __malloc_alloc_oom_handler;
                 if (my_malloc_handler == 0)
                     throw std::bad_alloc();
                 (*my_malloc_handler)();     // call the handler to release some memory
-                result = malloc(n);         // try again
+                result = align == 0 ? malloc(n) : __aligned_malloc(n, align);  // try again
                 if (result)
                     return result;
             }
         }
+
+        /*
+            Reclaim callbacks: 'f()' gives memory back and returns the bytes
+            released. Lower 'priority' runs first. A function-local registry,
+            so pools may register during static initialization.
+        */
+        static const int __RECLAIM_MAX = 16;
+
+        struct __reclaim_entry
+        {
+            size_t (*f)();
+            int priority;
+        };
+
+        struct __reclaim_registry
+        {
+            std::mutex lock;
+            __reclaim_entry entries[__RECLAIM_MAX];
+            int count = 0;
+            unsigned rounds = 3;
+        };
+
+        static __reclaim_registry& __registry()
+        {
+            static __reclaim_registry registry;
+            return registry;
+        }
+
+        // Set while the callbacks run: an allocation failing inside one goes straight to the handler.
+        static bool& __reclaiming()
+        {
+            static thread_local bool reclaiming = false;
+            return reclaiming;
+        }
+
+        // 'align' is a power of two; aligned_alloc wants a multiple of it.
+        static void* __aligned_malloc(size_t n, size_t align)
+        {
+            if (align < sizeof(void*))
+                align = sizeof(void*);
+            n = (n + align - 1) & ~(align - 1);
+#ifdef _MSC_VER
+            return _aligned_malloc(n, align);
+#else
+            return aligned_alloc(align, n);
+#endif
+        }
         // Function pointer:
         static void (*__malloc_alloc_oom_handler)();
 
@@ -45,31 +117,514 @@ namespace toy_std
             return result;
         }
         static void deallocate(void* p) { free(p); }
+
+        static void* allocate_aligned(size_t n, size_t align)
+        {
+            void* result = __aligned_malloc(n, align);
+            if (result == 0)
+                result = oom_malloc(n, align);
+            return result;
+        }
+        static void deallocate_aligned(void* p)
+        {
+#ifdef _MSC_VER
+            _aligned_free(p);
+#else
+            free(p);
+#endif
+        }
+
         static void (*set_malloc_handler(void (*f)()))()
         {
             void (*old)() = __malloc_alloc_oom_handler;
             __malloc_alloc_oom_handler = f;
             return (old);
         }
+
+        /*
+            Register a reclaim callback for the out-of-memory path. Returns
+            false if 'f' is already registered or the registry is full.
+        */
+        static bool register_reclaim(size_t (*f)(), int priority)
+        {
+            __reclaim_registry& r = __registry();
+            std::lock_guard<std::mutex> guard(r.lock);
+            if (r.count == __RECLAIM_MAX)
+                return false;
+            int i = 0;
+            for (; i < r.count; ++i)
+                if (r.entries[i].f == f)
+                    return false;
+            // Keep the entries sorted; equal priorities run in registration order.
+            for (i = r.count; i > 0 && r.entries[i - 1].priority > priority; --i)
+                r.entries[i] = r.entries[i - 1];
+            r.entries[i].f = f;
+            r.entries[i].priority = priority;
+            ++r.count;
+            return true;
+        }
+
+        static bool unregister_reclaim(size_t (*f)())
+        {
+            __reclaim_registry& r = __registry();
+            std::lock_guard<std::mutex> guard(r.lock);
+            for (int i = 0; i < r.count; ++i)
+                if (r.entries[i].f == f)
+                {
+                    for (--r.count; i < r.count; ++i)
+                        r.entries[i] = r.entries[i + 1];
+                    return true;
+                }
+            return false;
+        }
+
+        // Retry budget: rounds over every callback before giving up(default 3).
+        static void set_reclaim_rounds(unsigned rounds)
+        {
+            __reclaim_registry& r = __registry();
+            std::lock_guard<std::mutex> guard(r.lock);
+            r.rounds = rounds;
+        }
+
+        /*
+            Run the callbacks in priority order, calling 'retry()' after each
+            one that released something, until 'retry()' succeeds, the budget
+            is spent or a whole round releases nothing. Returns the result of
+            the successful 'retry()', or 0. Chunk sources use it as well.
+        */
+        template<typename Retry>
+        static void* reclaim_and_retry(Retry retry)
+        {
+            bool& reclaiming = __reclaiming();
+            if (reclaiming)
+                return 0;
+
+            __reclaim_registry& r = __registry();
+            __reclaim_entry entries[__RECLAIM_MAX];
+            int count;
+            unsigned rounds;
+            {
+                // Run on a copy: a callback may (un)register.
+                std::lock_guard<std::mutex> guard(r.lock);
+                count = r.count;
+                rounds = r.rounds;
+                for (int i = 0; i < count; ++i)
+                    entries[i] = r.entries[i];
+            }
+
+            void* result = 0;
+            reclaiming = true;
+            for (unsigned round = 0; round < rounds && result == 0; ++round)
+            {
+                size_t round_released = 0;
+                for (int i = 0; i < count && result == 0; ++i)
+                {
+                    size_t released = entries[i].f();
+                    round_released += released;
+                    if (released != 0)
+                        result = retry();
+                }
+                if (round_released == 0)
+                    break;
+            }
+            reclaiming = false;
+            return result;
+        }
     };
 
     using __malloc_alloc = __malloc_alloc_template<0>;
 
+    // Reclaim priority of the pools' own trim; register cheaper caches below it.
+    const int __RECLAIM_PRIORITY_POOL = 20;
+
     // Initialize the new_handler with 'nullptr'
-    void (*__malloc_alloc::__malloc_alloc_oom_handler)() = 0;
+    template<int inst>
+    void (*__malloc_alloc_template<inst>::__malloc_alloc_oom_handler)() = 0;
+
+    /*
+        Chunk sources: where the sub-allocator gets its chunks from.
+
+            static const size_t alignment;          -- of every chunk returned
+            static void* allocate(size_t& bytes);   -- may round 'bytes' up; 0 on failure
+            static void* oom_allocate(size_t& bytes); -- last try, throws on failure
+            static void deallocate(void* p, size_t bytes);
+    */
+    struct __malloc_chunk_source
+    {
+        static const size_t alignment = alignof(std::max_align_t);
+
+        static void* allocate(size_t& bytes) { return malloc(bytes); }
+        // Goes through the out-of-memory handler of __malloc_alloc.
+        static void* oom_allocate(size_t& bytes) { return __malloc_alloc::allocate(bytes); }
+        static void deallocate(void* p, size_t) { free(p); }
+    };
+
+#if defined(__unix__) || defined(__APPLE__)
+    /*
+        Anonymous mappings aligned to 'Granule'(2 MB by default, the x86-64
+        huge page size); with 'HugePages' every chunk is also advised
+        MADV_HUGEPAGE so the kernel backs it with transparent huge pages.
+        Chunk sizes are rounded up to whole granules.
+    */
+    template<bool HugePages = true, size_t Granule = size_t(2) << 20>
+    struct __mmap_chunk_source
+    {
+        static_assert((Granule & (Granule - 1)) == 0, "Granule must be a power of two");
+
+        static const size_t alignment = Granule;
+
+        static void* allocate(size_t& bytes)
+        {
+            bytes = (bytes + Granule - 1) & ~(Granule - 1);
+
+            // Map one granule more and cut the misaligned head/tail off.
+            char* p = (char*)mmap(0, bytes + Granule, PROT_READ | PROT_WRITE,
+                                  MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (p == (char*)MAP_FAILED)
+                return 0;
+            char* aligned = (char*)(((uintptr_t)p + Granule - 1) & ~(uintptr_t)(Granule - 1));
+            if (aligned != p)
+                munmap(p, aligned - p);
+            if (aligned + bytes != p + bytes + Granule)
+                munmap(aligned + bytes, p + Granule - aligned);
+#ifdef MADV_HUGEPAGE
+            if (HugePages)
+                madvise(aligned, bytes, MADV_HUGEPAGE);
+#endif
+            return aligned;
+        }
+        static void* oom_allocate(size_t& bytes)
+        {
+            void* p = __malloc_alloc::reclaim_and_retry([&bytes]() { return allocate(bytes); });
+            if (p == 0)
+                throw std::bad_alloc();
+            return p;
+        }
+        static void deallocate(void* p, size_t bytes) { munmap(p, bytes); }
+    };
+#else
+    // No mmap: keep the interface, fall back to malloc.
+    template<bool HugePages = true, size_t Granule = size_t(2) << 20>
+    struct __mmap_chunk_source : public __malloc_chunk_source { };
+#endif
+
+    constexpr size_t __log2_floor(size_t n) { return n <= 1 ? 0 : 1 + __log2_floor(n >> 1); }
+
+    // Natural alignment of the pool's blocks stops at a cache line.
+    const size_t __CACHE_LINE = 64;
+
+    /*
+        Size-class policy of the sub-allocator.
+
+            Align, 2*Align, ..., 16*Align           -- 16 linear classes
+            then 4 classes per power of two:
+            L + L/4, L + L/2, L + 3L/4, 2L, ...      -- up to MaxBytes
+            (L = 16*Align, the end of the linear part)
+
+        __size_classes<8, 128> is the classic SGI layout:
+            8,16,24,32,40,48,56,64,72,80,88,96,104,112,120,128
+        __size_classes<8, 4096> keeps those and adds
+            160,192,224,256, 320,...,512, ..., 3584,4096
+        Every class size is a multiple of Align. Blocks are also carved at
+        their class' natural alignment(align_of: the largest power of two
+        dividing the size, at most __CACHE_LINE): 16 -> 16, 48 -> 16,
+        64 -> 64, 96 -> 32, 192 -> 64 ... so over-aligned types only need
+        a class whose natural alignment is big enough(aligned_size).
+    */
+    template<size_t Align = 8, size_t MaxBytes = 128>
+    struct __size_classes
+    {
+        static_assert((Align & (Align - 1)) == 0 && Align >= sizeof(void*),
+                      "Align must be a power of two that can hold a free-list link");
+        static_assert((MaxBytes & (MaxBytes - 1)) == 0 && MaxBytes >= Align,
+                      "MaxBytes must be a power of two not less than Align");
+
+        static const size_t align = Align;
+        static const size_t max_bytes = MaxBytes;
+        static const size_t linear_bytes = 16 * Align < MaxBytes ? 16 * Align : MaxBytes;
+        static const size_t nlinear = linear_bytes / Align;
+        static const size_t nlists = nlinear + 4 * (__log2_floor(MaxBytes) - __log2_floor(linear_bytes));
+
+        static size_t round_up_align(size_t bytes) { return (bytes + Align - 1) & ~(Align - 1); }
+
+        // Smallest class holding 'bytes'(0 < bytes <= MaxBytes).
+        static size_t index(size_t bytes)
+        {
+            if (bytes <= linear_bytes)
+                return (bytes + Align - 1) / Align - 1;
+            size_t k = __log2_floor(bytes - 1);         // 2^k < bytes <= 2^(k+1)
+            size_t base = size_t(1) << k;
+            size_t step = base >> 2;
+            return nlinear + 4 * (k - __log2_floor(linear_bytes))
+                   + (bytes - base + step - 1) / step - 1;
+        }
+
+        static size_t size_of(size_t idx)
+        {
+            if (idx < nlinear)
+                return (idx + 1) * Align;
+            size_t base = linear_bytes << ((idx - nlinear) / 4);
+            return base + ((idx - nlinear) % 4 + 1) * (base >> 2);
+        }
+
+        static size_t round_up(size_t bytes) { return size_of(index(bytes)); }
 
-    const size_t __ALIGN = 8;   // round_up bound
-    const size_t __MAX_BYTES = 128;
-    const size_t __NFREELISTS = __MAX_BYTES / __ALIGN;
+        static size_t align_of(size_t idx)
+        {
+            size_t size = size_of(idx);
+            size_t a = size & (~size + 1);      // lowest set bit
+            return a < __CACHE_LINE ? a : __CACHE_LINE;
+        }
+
+        /*
+            Size of the smallest class holding 'bytes' at alignment 'align';
+            0 if no class does(bigger than MaxBytes or than a cache line).
+        */
+        static size_t aligned_size(size_t bytes, size_t align)
+        {
+            if (bytes < align)
+                bytes = align;
+            if (bytes > MaxBytes || align > __CACHE_LINE)
+                return 0;
+            size_t idx = index(bytes);
+            while (idx < nlists && align_of(idx) < align)
+                ++idx;
+            return idx < nlists ? size_of(idx) : 0;
+        }
+
+        // Largest class not bigger than 'bytes'(bytes >= Align).
+        static size_t floor_index(size_t bytes)
+        {
+            if (bytes >= MaxBytes)
+                return nlists - 1;
+            size_t idx = index(bytes);
+            return size_of(idx) > bytes ? idx - 1 : idx;
+        }
+
+        // How many blocks a refill carves: 20 for the small classes,
+        // fewer for the big ones so a refill stays around 20 * linear_bytes.
+        static int refill_count(size_t size)
+        {
+            if (size <= linear_bytes)
+                return 20;
+            size_t n = 20 * linear_bytes / size;
+            return n < 4 ? 4 : int(n);
+        }
+    };
+
+    // Keeps tlist nodes and the 512-byte tdeque buffers inside the pool.
+    using __default_size_classes = __size_classes<8, 4096>;
+
+    /*
+        Statistics of the sub-allocator.
+        Compiled in only with '__TOY_ALLOC_STATS' defined; otherwise every
+        __TOY_ALLOC_STAT(...) vanishes and stats() returns zeros.
+        With the thread caches in front, the per-class counters see the
+        magazine traffic(batches), not every client call.
+    */
+#ifdef __TOY_ALLOC_STATS
+#define __TOY_ALLOC_STAT(stmt) stmt
+#else
+#define __TOY_ALLOC_STAT(stmt)
+#endif
+
+    struct __alloc_class_stats
+    {
+        size_t block_size;
+        size_t allocs;          // blocks handed out
+        size_t frees;           // blocks given back
+        size_t hits;            // blocks served from the free list
+        size_t refills;         // trips to chunk_alloc
+        size_t batch_takes;     // __take_batch calls(thread-cache refills)
+        size_t batch_gives;     // __give_batch calls(thread-cache flushes)
+    };
+
+    template<size_t NLists>
+    struct __alloc_stats
+    {
+        __alloc_class_stats classes[NLists];
+        size_t chunk_allocs;        // chunk_alloc calls
+        size_t chunk_mallocs;       // new chunks taken from the system
+        size_t heap_bytes;          // heap_size: bytes held in chunks
+        size_t stranded_bytes;      // unused tail of the current chunk
+        size_t idle_bytes;          // bytes on the free lists(locked instance)
+        size_t malloc_fallbacks;    // requests above max_bytes
+        size_t trims;
+        size_t trimmed_bytes;
+    };
+
+    template<size_t NLists>
+    struct __alloc_counters
+    {
+        std::atomic<size_t> allocs[NLists];
+        std::atomic<size_t> frees[NLists];
+        std::atomic<size_t> hits[NLists];
+        std::atomic<size_t> refills[NLists];
+        std::atomic<size_t> batch_takes[NLists];
+        std::atomic<size_t> batch_gives[NLists];
+        std::atomic<size_t> chunk_allocs;
+        std::atomic<size_t> chunk_mallocs;
+        std::atomic<size_t> malloc_fallbacks;
+        std::atomic<size_t> trims;
+        std::atomic<size_t> trimmed_bytes;
+
+        static void bump(std::atomic<size_t>& c, size_t n = 1) { c.fetch_add(n, std::memory_order_relaxed); }
+    };
+
+    /*
+        Instances of the sub-allocator:
+            __DEFAULT_ALLOC_INST  -- free lists guarded by one pool mutex
+            __LOCKFREE_ALLOC_INST -- lock-free free lists, only the
+                                     chunk_alloc() refill is serialized
+    */
+    const int __DEFAULT_ALLOC_INST = 0;
+    const int __LOCKFREE_ALLOC_INST = 1;
 
     template<int inst>
+    struct __pool_traits
+    {
+        using is_lock_free = __false_type;
+    };
+
+    __STL_TEMPLATE_NULL struct __pool_traits<__LOCKFREE_ALLOC_INST>
+    {
+        using is_lock_free = __true_type;
+    };
+
+    /* Locks */
+    struct __null_lock
+    {
+        void lock() { }
+        void unlock() { }
+        bool try_lock() { return true; }
+    };
+
+    class __spin_lock
+    {
+    public:
+        void lock()
+        {
+            while (__flag.test_and_set(std::memory_order_acquire))
+                std::this_thread::yield();
+        }
+        void unlock() { __flag.clear(std::memory_order_release); }
+        bool try_lock() { return !__flag.test_and_set(std::memory_order_acquire); }
+
+    private:
+        std::atomic_flag __flag = ATOMIC_FLAG_INIT;
+    };
+
+    /*
+        Free-list heads.
+        'Node' must have a 'free_list_link' member (the pool's 'obj').
+    */
+    template<typename Node, typename LockFree>
+    struct __free_list;
+
+    // Plain stack: the caller holds the pool lock.
+    template<typename Node>
+    struct __free_list<Node, __false_type>
+    {
+        Node* head;
+
+        Node* pop()
+        {
+            Node* result = head;
+            if (result != 0)
+                head = result->free_list_link;
+            return result;
+        }
+        void push(Node* p) { push_chain(p, p); }
+        void push_chain(Node* first, Node* last)
+        {
+            last->free_list_link = head;
+            head = first;
+        }
+    };
+
+    /*
+        Treiber stack with a tagged head to defeat ABA:
+
+            63        48 47                          0
+            |   tag    |          Node*              |   (64-bit)
+            |       tag        |      Node*          |   (32-bit: 32/32)
+
+        Every successful CAS bumps the tag, so a head that was popped and
+        pushed back in between is never mistaken for the old one.
+        Popped blocks are never unmapped while the pool lives, so reading
+        'free_list_link' of a stale head is harmless: the CAS fails.
+    */
+    template<typename Node>
+    struct __free_list<Node, __true_type>
+    {
+        using __tagged = unsigned long long;
+        static const int __TAG_SHIFT = sizeof(void*) == 8 ? 48 : 32;
+        static const __tagged __PTR_MASK = (__tagged(1) << __TAG_SHIFT) - 1;
+
+        std::atomic<__tagged> head;
+
+        static Node* __ptr(__tagged t) { return (Node*)(uintptr_t)(t & __PTR_MASK); }
+        static __tagged __next_tag(__tagged t, Node* p)
+        {
+            return (((t >> __TAG_SHIFT) + 1) << __TAG_SHIFT) | ((__tagged)(uintptr_t)p & __PTR_MASK);
+        }
+
+        Node* pop()
+        {
+            __tagged old = head.load(std::memory_order_acquire);
+            while (true)
+            {
+                Node* result = __ptr(old);
+                if (result == 0)
+                    return 0;
+                Node* next = result->free_list_link;
+                if (head.compare_exchange_weak(old, __next_tag(old, next),
+                                               std::memory_order_acq_rel, std::memory_order_acquire))
+                    return result;
+            }
+        }
+        void push(Node* p) { push_chain(p, p); }
+        void push_chain(Node* first, Node* last)
+        {
+            __tagged old = head.load(std::memory_order_relaxed);
+            do
+                last->free_list_link = __ptr(old);
+            while (!head.compare_exchange_weak(old, __next_tag(old, first),
+                                               std::memory_order_release, std::memory_order_relaxed));
+        }
+    };
+
+    template<typename LockFree> struct __pool_locks;
+
+    template<> struct __pool_locks<__false_type>
+    {
+        using list_lock = std::mutex;   // free lists + chunk state
+        using chunk_lock = __null_lock; // already covered by list_lock
+    };
+
+    template<> struct __pool_locks<__true_type>
+    {
+        using list_lock = __null_lock;  // lists are lock-free
+        using chunk_lock = __spin_lock; // refill path only
+    };
+
+    /*
+        The sub-allocator is shared by every thread. Hot paths should go
+        through the per-thread magazines in toy_stl_thread_alloc.hpp,
+        which only touch the pool with '__take_batch/__give_batch'.
+    */
+    template<int inst,
+             typename SizeClass = __default_size_classes,
+             typename ChunkSource = __malloc_chunk_source>
     class __default_alloc_template
     {
+    public:
+        using size_class = SizeClass;
+
     private:
         static size_t ROUND_UP(size_t bytes)
         {
-            // at least 8 bytes
-            return ((bytes + __ALIGN - 1) & ~(__ALIGN - 1));
+            return SizeClass::round_up(bytes);
         }
 
         union obj
@@ -79,36 +634,80 @@ namespace toy_std
             char client_data[1];        // The client sees this.
         };
 
-        /*
-            16 free-lists
-            manage blocks size of:
-            8,16,24,32,40,48,56,64,72,80,88,96,104,112,120,128
-        */
-        static obj* volatile free_list[__NFREELISTS];
+        using is_lock_free = typename __pool_traits<inst>::is_lock_free;
+        using free_list_type = __free_list<obj, is_lock_free>;
+        using list_lock_type = typename __pool_locks<is_lock_free>::list_lock;
+        using chunk_lock_type = typename __pool_locks<is_lock_free>::chunk_lock;
+
+        // One free-list per size class(see __size_classes).
+        static free_list_type free_list[SizeClass::nlists];
 
         static size_t FREELIST_INDEX(size_t bytes)
         {
             // Decide which free_list to be used according to
             // the block size.
-            return ((bytes + __ALIGN - 1) / __ALIGN - 1);
+            return SizeClass::index(bytes);
+        }
+
+        /* Free-list access: keeps '__idle_bytes' in step(locked instance only) */
+        static obj* __pop(size_t idx)
+        {
+            obj* result = free_list[idx].pop();
+            if (result != 0)
+                __count_idle(-(ptrdiff_t)SizeClass::size_of(idx), is_lock_free());
+            return result;
+        }
+        static void __push_chain(size_t idx, obj* first, obj* last, int nobjs)
+        {
+            free_list[idx].push_chain(first, last);
+            __count_idle((ptrdiff_t)(nobjs * SizeClass::size_of(idx)), is_lock_free());
+        }
+        static void __push(size_t idx, obj* p) { __push_chain(idx, p, p, 1); }
+
+        static void __count_idle(ptrdiff_t bytes, __false_type) { __idle_bytes += bytes; }
+        static void __count_idle(ptrdiff_t, __true_type) { }
+
+        /*
+            Cut [p, p + bytes) into blocks of the largest fitting classes
+            whose natural alignment 'p' meets(the Align class always does).
+        */
+        static void __shed(char* p, size_t bytes)
+        {
+            while (bytes >= SizeClass::align)
+            {
+                size_t idx = SizeClass::floor_index(bytes);
+                while (((uintptr_t)p & (SizeClass::align_of(idx) - 1)) != 0)
+                    --idx;
+                size_t sz = SizeClass::size_of(idx);
+                __push(idx, (obj*)p);
+                p += sz;
+                bytes -= sz;
+            }
         }
 
         static void* refill(size_t n)
         {
-            // default: get 20 new blocks
-            int nobjs = 20;
+            std::lock_guard<chunk_lock_type> guard(__chunk_lock);
+
+            // Another thread may have refilled the list while we waited.
+            size_t idx = FREELIST_INDEX(n);
+            obj* result = __pop(idx);
+            if (result != 0)
+                return result;
+
+            // default: get 20 new blocks(fewer for the big classes)
+            int nobjs = SizeClass::refill_count(n);
+            __TOY_ALLOC_STAT(__counters.bump(__counters.refills[idx]));
+            __TOY_ALLOC_STAT(__counters.bump(__counters.chunk_allocs));
             char* chunk = chunk_alloc(n, nobjs);
-            obj* volatile* my_free_list;
-            obj* result;
             obj* current_obj, * next_obj;
             int i;
 
             if (nobjs == 1)return chunk;
-            my_free_list = free_list + FREELIST_INDEX(n);
 
             // Build free-list on the chunk:
             result = (obj*)chunk;
-            *my_free_list = next_obj = (obj*)(chunk + n);
+            next_obj = (obj*)(chunk + n);
             for (i = 1;; i++)
             {
                 // start from 1:
@@ -116,13 +715,11 @@ namespace toy_std
                 current_obj = next_obj;
                 next_obj = (obj*)((char*)next_obj + n);
                 if (nobjs - 1 == i)
-                {
-                    current_obj->free_list_link = 0;
                     break;
-                }
                 else
                     current_obj->free_list_link = next_obj;
             }
+            __push_chain(idx, (obj*)(chunk + n), current_obj, nobjs - 1);
             return result;
         }
         static char* chunk_alloc(size_t size, int& nobjs)
@@ -130,15 +727,33 @@ namespace toy_std
             /* Mantain a memory pool */
             char* result;
             size_t total_bytes = size * nobjs;
+
+            // Carve at the natural alignment of the class; the gap in
+            // front goes to the free lists of smaller classes.
+            size_t align = SizeClass::align_of(FREELIST_INDEX(size));
+            char* aligned = (char*)(((uintptr_t)start_free + align - 1) & ~(uintptr_t)(align - 1));
             size_t bytes_left = end_free - start_free; // free-space in memory pool
+            size_t usable = bytes_left;                 // of it, from the aligned start
+            if (aligned != start_free)
+            {
+                usable = aligned < end_free ? end_free - aligned : 0;
+                if (usable >= size)
+                {
+                    __shed(start_free, aligned - start_free);
+                    start_free = aligned;
+                    bytes_left = usable;
+                }
+                else
+                    usable = 0;
+            }
 
-            if (bytes_left >= total_bytes)
+            if (usable >= total_bytes)
             {
                 result = start_free;
                 start_free += total_bytes;
                 return result;
             }
-            else if (bytes_left >= size)
+            else if (usable >= size)
             {
                 // Unable to give all memory the nobjs need
                 // but try to give the max memory the pool can.
@@ -150,18 +765,15 @@ namespace toy_std
             }
             else
             {
-                size_t bytes_to_get = 2 * total_bytes + ROUND_UP(heap_size >> 4);
+                size_t bytes_to_get = 2 * total_bytes + SizeClass::round_up_align(heap_size >> 4);
+                // New chunks are only Align-aligned: leave room to realign.
+                bytes_to_get += align - SizeClass::align;
                 // Try to use the unused blocks in memory pool:
                 if (bytes_left > 0)
-                {
-                    obj* volatile* my_free_list =
-                        free_list + FREELIST_INDEX(bytes_left);
-                    ((obj*)start_free)->free_list_link = *my_free_list;
-                    *my_free_list = (obj*)start_free;
-                }
+                    __shed(start_free, bytes_left);
 
                 // allocate new heap-space for memory pool
-                start_free = (char*)malloc(bytes_to_get);
+                start_free = __new_chunk(bytes_to_get, false);
 
                 if (start_free == 0)
                 {
@@ -170,22 +782,23 @@ namespace toy_std
                         expanding the memory pool.
                     */
                     size_t i;
-                    obj* volatile* my_free_list, * p;
-                    for (i = size; i <= __MAX_BYTES; i += __ALIGN)
+                    obj* p;
+                    for (i = FREELIST_INDEX(size); i < SizeClass::nlists; ++i)
                     {
-                        my_free_list = free_list + FREELIST_INDEX(i);
-                        p = *my_free_list;
+                        // Only blocks aligned enough to carve at their start.
+                        if (SizeClass::align_of(i) < align)
+                            continue;
+                        p = __pop(i);
                         if (p != 0)
                         {
                             // find unused blocks in free list
-                            *my_free_list = p->free_list_link;
                             start_free = (char*)p;
-                            end_free = start_free + i;
+                            end_free = start_free + SizeClass::size_of(i);
                             return chunk_alloc(size, nobjs);
                         }
                     }
                     end_free = 0;
-                    start_free = (char*)__malloc_alloc::allocate(bytes_to_get);
+                    start_free = __new_chunk(bytes_to_get, true);
 
                 }
                 heap_size += bytes_to_get;
@@ -196,57 +809,540 @@ namespace toy_std
 
         }
 
+        /*
+            Chunk bookkeeping:
+
+                raw ---> | slack | header | blocks ...................... |
+                                  ^        ^
+                                  |        returned by __new_chunk()
+                                  Align-aligned
+
+            The chunk source may align less than the size-class policy wants
+            (malloc: alignof(max_align_t)); then ask for a little more and
+            align the header by hand. A source may also round the request
+            up(mmap: whole 2 MB granules), 'bytes' reports what was usable.
+            Headers are chained in '__chunks' so trim() can find chunks whose
+            every byte is back in the free lists and hand them back.
+        */
+        struct __chunk_header
+        {
+            __chunk_header* next;
+            void* raw;          // what the chunk source returned
+            size_t raw_bytes;   // and its size
+            size_t bytes;       // usable bytes after the header
+            size_t idle;        // scratch of trim(): free bytes found in this chunk
+        };
+
+        static const size_t __CHUNK_SLACK =
+            SizeClass::align > ChunkSource::alignment ? SizeClass::align : 0;
+        static const size_t __CHUNK_HEADER =
+            (sizeof(__chunk_header) + SizeClass::align - 1) & ~(SizeClass::align - 1);
+
+        static char* __new_chunk(size_t& bytes, bool oom_path)
+        {
+            static const bool __registered = __register_reclaim(is_lock_free());
+            (void)__registered;
+
+            size_t total = bytes + __CHUNK_HEADER + __CHUNK_SLACK;
+            void* raw;
+            if (oom_path)
+            {
+                // We hold '__pool_lock' here: our own reclaim callback must stay out.
+                __holds_pool_lock() = true;
+                try { raw = ChunkSource::oom_allocate(total); }
+                catch (...) { __holds_pool_lock() = false; throw; }
+                __holds_pool_lock() = false;
+            }
+            else
+                raw = ChunkSource::allocate(total);
+            if (raw == 0)
+                return 0;
+
+            __chunk_header* h = (__chunk_header*)
+                (((uintptr_t)raw + SizeClass::align - 1) & ~(uintptr_t)(SizeClass::align - 1));
+            char* data = (char*)h + __CHUNK_HEADER;
+            // Whole Align units only: a shorter tail could never be shed,
+            // and the chunk would never look idle to trim().
+            bytes = ((char*)raw + total - data) & ~(SizeClass::align - 1);
+            h->next = __chunks;
+            h->raw = raw;
+            h->raw_bytes = total;
+            h->bytes = bytes;
+            __chunks = h;
+            __TOY_ALLOC_STAT(__counters.bump(__counters.chunk_mallocs));
+            return (char*)h + __CHUNK_HEADER;
+        }
+
+        static int __chunk_cmp(const void* a, const void* b)
+        {
+            uintptr_t x = (uintptr_t)*(__chunk_header* const*)a;
+            uintptr_t y = (uintptr_t)*(__chunk_header* const*)b;
+            return x < y ? -1 : (x > y ? 1 : 0);
+        }
+
+        static __chunk_header* __chunk_of(__chunk_header** sorted, size_t n, const char* p)
+        {
+            // Last chunk starting below 'p'.
+            size_t lo = 0, hi = n;
+            while (lo < hi)
+            {
+                size_t mid = (lo + hi) / 2;
+                if ((const char*)sorted[mid] < p)
+                    lo = mid + 1;
+                else
+                    hi = mid;
+            }
+            if (lo == 0)
+                return 0;
+            __chunk_header* h = sorted[lo - 1];
+            const char* data = (const char*)h + __CHUNK_HEADER;
+            return (p >= data && p < data + h->bytes) ? h : 0;
+        }
+
+        static bool __is_empty_chunk(const __chunk_header* h)
+        {
+            return h != 0 && h->idle == h->bytes;
+        }
+
+        /*
+            Release every chunk whose blocks are all on the free lists.
+            Blocks cached in thread magazines keep their chunk alive.
+            Only called with '__pool_lock' held(locked instance).
+        */
+        static size_t __trim_locked()
+        {
+            size_t nchunks = 0, released = 0;
+            for (__chunk_header* h = __chunks; h != 0; h = h->next)
+                ++nchunks;
+            __chunk_header** sorted =
+                nchunks == 0 ? 0 : (__chunk_header**)malloc(nchunks * sizeof(__chunk_header*));
+            if (sorted == 0)
+                return 0;
+
+            size_t i = 0;
+            for (__chunk_header* h = __chunks; h != 0; h = h->next, ++i)
+            {
+                h->idle = 0;
+                sorted[i] = h;
+            }
+            qsort(sorted, nchunks, sizeof(__chunk_header*), __chunk_cmp);
+
+            // Count the free bytes of every chunk.
+            for (size_t idx = 0; idx < SizeClass::nlists; ++idx)
+                for (obj* p = free_list[idx].head; p != 0; p = p->free_list_link)
+                {
+                    __chunk_header* h = __chunk_of(sorted, nchunks, (char*)p);
+                    if (h != 0)
+                        h->idle += SizeClass::size_of(idx);
+                }
+            __chunk_header* tail = start_free == end_free ? 0 : __chunk_of(sorted, nchunks, start_free);
+            if (tail != 0)
+                tail->idle += end_free - start_free;
+
+            bool any = false;
+            for (i = 0; i < nchunks && !any; ++i)
+                any = __is_empty_chunk(sorted[i]);
+
+            if (any)
+            {
+                // Unthread the blocks of the empty chunks.
+                for (size_t idx = 0; idx < SizeClass::nlists; ++idx)
+                {
+                    obj** link = &free_list[idx].head;
+                    while (*link != 0)
+                    {
+                        if (__is_empty_chunk(__chunk_of(sorted, nchunks, (char*)*link)))
+                        {
+                            *link = (*link)->free_list_link;
+                            __idle_bytes -= SizeClass::size_of(idx);
+                        }
+                        else
+                            link = &(*link)->free_list_link;
+                    }
+                }
+                if (__is_empty_chunk(tail))
+                    start_free = end_free = 0;
+
+                __chunk_header** link = &__chunks;
+                while (*link != 0)
+                {
+                    __chunk_header* h = *link;
+                    if (__is_empty_chunk(h))
+                    {
+                        *link = h->next;
+                        heap_size -= h->bytes;
+                        released += h->bytes;
+                        ChunkSource::deallocate(h->raw, h->raw_bytes);
+                    }
+                    else
+                        link = &h->next;
+                }
+            }
+
+            free(sorted);
+            __next_trim_at = __idle_bytes + __trim_threshold;
+            __TOY_ALLOC_STAT(__counters.bump(__counters.trims));
+            __TOY_ALLOC_STAT(__counters.bump(__counters.trimmed_bytes, released));
+            return released;
+        }
+
+        static size_t __trim(__false_type)
+        {
+            std::lock_guard<list_lock_type> guard(__pool_lock);
+            return __trim_locked();
+        }
+
+        /*
+            Lock-free instance: a racing pop() may still read the link of a
+            block it saw as the head, so its chunks are never unmapped.
+        */
+        static size_t __trim(__true_type) { return 0; }
+
+        /*
+            Reclaim callback(see __malloc_alloc_template::register_reclaim):
+            trim under memory pressure, but never wait for the lock, and skip
+            when the failing allocation is our own refill.
+        */
+        static size_t __reclaim()
+        {
+            if (__holds_pool_lock())
+                return 0;
+            std::unique_lock<list_lock_type> guard(__pool_lock, std::try_to_lock);
+            return guard.owns_lock() ? __trim_locked() : 0;
+        }
+
+        static bool& __holds_pool_lock()
+        {
+            static thread_local bool holds = false;
+            return holds;
+        }
+
+        // Registered once, with the first chunk; the lock-free instance has nothing to trim.
+        static bool __register_reclaim(__false_type)
+        {
+            return __malloc_alloc::register_reclaim(&__reclaim, __RECLAIM_PRIORITY_POOL);
+        }
+        static bool __register_reclaim(__true_type) { return false; }
+
+        // Automatic trim once more than '__trim_threshold' bytes sit idle.
+        static void __maybe_trim(__false_type)
+        {
+            if (__trim_threshold != 0 && __idle_bytes > __next_trim_at)
+                __trim_locked();
+        }
+        static void __maybe_trim(__true_type) { }
+
         // Chunk allocation state
         static char* start_free;    // memory pool start, only be modified by chunk_alloc()
         static char* end_free;      // memory pool end, only be modified by chunk_alloc()
         static size_t heap_size;
+        static __chunk_header* __chunks;
+
+        // Bytes sitting on the free lists(locked instance) and the trim knobs.
+        static size_t __idle_bytes;
+        static size_t __trim_threshold;
+        static size_t __next_trim_at;
+
+        // Blocks moved under one lock acquisition: about 256 KB worth.
+        static size_t __batch_limit(size_t n)
+        {
+            size_t limit = (size_t(256) << 10) / SizeClass::round_up(n);
+            return limit < 1 ? 1 : limit;
+        }
+
+        static list_lock_type __pool_lock;      // guards free_list(locked instance)
+        static chunk_lock_type __chunk_lock;    // guards the chunk state above(lock-free instance)
+
+#ifdef __TOY_ALLOC_STATS
+        static __alloc_counters<SizeClass::nlists> __counters;
+#endif
 
     public:
+        using stats_type = __alloc_stats<SizeClass::nlists>;
+
         static void* allocate(size_t n)
         {
-            if (n > __MAX_BYTES)
+            if (n > SizeClass::max_bytes)
+            {
+                __TOY_ALLOC_STAT(__counters.bump(__counters.malloc_fallbacks));
                 return __malloc_alloc::allocate(n);
+            }
 
-            obj* volatile* my_free_list;
-            obj* result;
-
-            my_free_list = free_list + FREELIST_INDEX(n);
-            result = *my_free_list;
+            std::lock_guard<list_lock_type> guard(__pool_lock);
+            __TOY_ALLOC_STAT(__counters.bump(__counters.allocs[FREELIST_INDEX(n)]));
+            obj* result = __pop(FREELIST_INDEX(n));
             if (result == 0)
             {
                 // no free-mem could be used; refill the free-list.
                 void* r = refill(ROUND_UP(n));
                 return r;
             }
-
-            // Modify the free list
-            *my_free_list = result->free_list_link;
+            __TOY_ALLOC_STAT(__counters.bump(__counters.hits[FREELIST_INDEX(n)]));
             return result;
         }
         static void deallocate(void* p, size_t n)
         {
-            if (n > __MAX_BYTES)
+            if (n > SizeClass::max_bytes)
             {
                 __malloc_alloc::deallocate(p);
                 return;
             }
 
-            obj* q = (obj*)p;
-            obj* volatile* my_free_list = free_list + FREELIST_INDEX(n);
+            std::lock_guard<list_lock_type> guard(__pool_lock);
+            __TOY_ALLOC_STAT(__counters.bump(__counters.frees[FREELIST_INDEX(n)]));
+            __push(FREELIST_INDEX(n), (obj*)p);
+            __maybe_trim(is_lock_free());
+        }
 
-            q->free_list_link = *my_free_list;
-            *my_free_list = q;
+        /*
+            'align' must be a power of two. Up to a cache line the block
+            comes from the class with enough natural alignment; anything
+            bigger goes to aligned_alloc. Free with the same 'n' and 'align'.
+        */
+        static void* allocate_aligned(size_t n, size_t align)
+        {
+            if (align <= SizeClass::align)
+                return allocate(n);
+            size_t size = SizeClass::aligned_size(n, align);
+            return size != 0 ? allocate(size) : __malloc_alloc::allocate_aligned(n, align);
+        }
+        static void deallocate_aligned(void* p, size_t n, size_t align)
+        {
+            if (align <= SizeClass::align)
+            {
+                deallocate(p, n);
+                return;
+            }
+            size_t size = SizeClass::aligned_size(n, align);
+            if (size != 0)
+                deallocate(p, size);
+            else
+                __malloc_alloc::deallocate_aligned(p);
+        }
+
+        /*
+            Move up to 'nobjs' blocks of size 'n'(n <= max_bytes) into 'out'
+            under a single lock acquisition. Returns the number of blocks
+            actually handed out (at least 1; chunk_alloc may shrink the batch).
+        */
+        static int __take_batch(size_t n, int nobjs, void** out)
+        {
+            std::lock_guard<list_lock_type> guard(__pool_lock);
+            size_t idx = FREELIST_INDEX(n);
+            int got = 0;
+            obj* result;
+            while (got < nobjs && (result = __pop(idx)) != 0)
+                out[got++] = result;
+            __TOY_ALLOC_STAT(__counters.bump(__counters.batch_takes[idx]));
+            __TOY_ALLOC_STAT(__counters.bump(__counters.hits[idx], got));
+            if (got == nobjs)
+            {
+                __TOY_ALLOC_STAT(__counters.bump(__counters.allocs[idx], got));
+                return got;
+            }
 
+            // Carve the rest straight from the memory pool,
+            // no need to thread them through the free-list first.
+            std::lock_guard<chunk_lock_type> chunk_guard(__chunk_lock);
+            size_t size = ROUND_UP(n);
+            int want = nobjs - got;
+            __TOY_ALLOC_STAT(__counters.bump(__counters.refills[idx]));
+            __TOY_ALLOC_STAT(__counters.bump(__counters.chunk_allocs));
+            char* chunk;
+            try
+            {
+                chunk = chunk_alloc(size, want);
+            }
+            catch (...)
+            {
+                // Nothing leaves a failed round: the free-list blocks go back.
+                while (got > 0)
+                    __push(idx, (obj*)out[--got]);
+                throw;
+            }
+            for (int i = 0; i < want; ++i)
+                out[got++] = chunk + i * size;
+            __TOY_ALLOC_STAT(__counters.bump(__counters.allocs[idx], got));
+            return got;
+        }
+
+        // Give 'nobjs' blocks of size 'n' back to their free-list at once.
+        static void __give_batch(size_t n, int nobjs, void** in)
+        {
+            if (nobjs <= 0)
+                return;
+
+            // Link the batch before taking the lock.
+            for (int i = 0; i + 1 < nobjs; ++i)
+                ((obj*)in[i])->free_list_link = (obj*)in[i + 1];
+
+            std::lock_guard<list_lock_type> guard(__pool_lock);
+            __TOY_ALLOC_STAT(__counters.bump(__counters.batch_gives[FREELIST_INDEX(n)]));
+            __TOY_ALLOC_STAT(__counters.bump(__counters.frees[FREELIST_INDEX(n)], nobjs));
+            __push_chain(FREELIST_INDEX(n), (obj*)in[0], (obj*)in[nobjs - 1], nobjs);
+            __maybe_trim(is_lock_free());
+        }
+
+        /*
+            Fill out[0, count) with blocks of size 'n'. Every round(up to
+            __batch_limit blocks) takes the lock once: free-list blocks
+            first, the rest carved in one piece from the memory pool.
+            If a round throws, the blocks of the earlier ones go back.
+        */
+        static void allocate_batch(size_t n, size_t count, void** out)
+        {
+            size_t done = 0;
+            try
+            {
+                if (n > SizeClass::max_bytes)
+                {
+                    for (; done < count; ++done)
+                        out[done] = allocate(n);
+                    return;
+                }
+                size_t limit = __batch_limit(n);
+                while (done < count)
+                {
+                    size_t left = count - done;
+                    int want = int(left < limit ? left : limit);
+                    done += __take_batch(n, want, out + done);
+                }
+            }
+            catch (...)
+            {
+                deallocate_batch(n, done, out);
+                throw;
+            }
+        }
+
+        // Give in[0, count) back, one lock acquisition per round.
+        static void deallocate_batch(size_t n, size_t count, void** in)
+        {
+            if (n > SizeClass::max_bytes)
+            {
+                for (size_t i = 0; i < count; ++i)
+                    deallocate(in[i], n);
+                return;
+            }
+            size_t limit = __batch_limit(n);
+            while (count > 0)
+            {
+                int nobjs = int(count < limit ? count : limit);
+                __give_batch(n, nobjs, in);
+                in += nobjs;
+                count -= nobjs;
+            }
+        }
+
+        /*
+            Give fully free chunks back to the system; returns the bytes
+            released. Always 0 for the lock-free instance.
+        */
+        static size_t trim() { return __trim(is_lock_free()); }
+
+        /*
+            Trim automatically whenever the free lists have grown by more
+            than 'bytes' since the last trim. 0(the default) turns it off.
+        */
+        static void set_trim_threshold(size_t bytes)
+        {
+            std::lock_guard<list_lock_type> guard(__pool_lock);
+            __trim_threshold = bytes;
+            __next_trim_at = __idle_bytes + bytes;
+        }
+
+        // Snapshot of the counters; all zero without '__TOY_ALLOC_STATS'.
+        static stats_type stats()
+        {
+            stats_type st = { };
+            for (size_t i = 0; i < SizeClass::nlists; ++i)
+                st.classes[i].block_size = SizeClass::size_of(i);
+#ifdef __TOY_ALLOC_STATS
+            std::lock_guard<list_lock_type> guard(__pool_lock);
+            std::lock_guard<chunk_lock_type> chunk_guard(__chunk_lock);
+            for (size_t i = 0; i < SizeClass::nlists; ++i)
+            {
+                __alloc_class_stats& c = st.classes[i];
+                c.allocs = __counters.allocs[i].load(std::memory_order_relaxed);
+                c.frees = __counters.frees[i].load(std::memory_order_relaxed);
+                c.hits = __counters.hits[i].load(std::memory_order_relaxed);
+                c.refills = __counters.refills[i].load(std::memory_order_relaxed);
+                c.batch_takes = __counters.batch_takes[i].load(std::memory_order_relaxed);
+                c.batch_gives = __counters.batch_gives[i].load(std::memory_order_relaxed);
+            }
+            st.chunk_allocs = __counters.chunk_allocs.load(std::memory_order_relaxed);
+            st.chunk_mallocs = __counters.chunk_mallocs.load(std::memory_order_relaxed);
+            st.malloc_fallbacks = __counters.malloc_fallbacks.load(std::memory_order_relaxed);
+            st.trims = __counters.trims.load(std::memory_order_relaxed);
+            st.trimmed_bytes = __counters.trimmed_bytes.load(std::memory_order_relaxed);
+            st.heap_bytes = heap_size;
+            st.stranded_bytes = end_free - start_free;
+            st.idle_bytes = __idle_bytes;
+#endif
+            return st;
+        }
+
+        static void dump_stats(std::ostream& os)
+        {
+#ifdef __TOY_ALLOC_STATS
+            stats_type st = stats();
+            os << "pool<" << inst << ">: heap " << st.heap_bytes
+               << " B, idle " << st.idle_bytes
+               << " B, stranded " << st.stranded_bytes
+               << " B, chunk_alloc " << st.chunk_allocs
+               << ", new chunks " << st.chunk_mallocs
+               << ", malloc fallbacks " << st.malloc_fallbacks
+               << ", trims " << st.trims << " (" << st.trimmed_bytes << " B)\n";
+            os << "  size\tallocs\tfrees\thits\trefills\ttakes\tgives\n";
+            for (size_t i = 0; i < SizeClass::nlists; ++i)
+            {
+                const __alloc_class_stats& c = st.classes[i];
+                if (c.allocs == 0 && c.frees == 0)
+                    continue;
+                os << "  " << c.block_size << '\t' << c.allocs << '\t' << c.frees << '\t'
+                   << c.hits << '\t' << c.refills << '\t' << c.batch_takes << '\t'
+                   << c.batch_gives << '\n';
+            }
+#else
+            os << "pool<" << inst << ">: statistics disabled(define __TOY_ALLOC_STATS)\n";
+#endif
         }
     };
 
-    using __default_alloc = __default_alloc_template<0>;
+    using __default_alloc = __default_alloc_template<__DEFAULT_ALLOC_INST>;
+    using __lockfree_alloc = __default_alloc_template<__LOCKFREE_ALLOC_INST>;
+    // For large heaps: 2 MB aligned chunks on transparent huge pages.
+    using __hugepage_alloc =
+        __default_alloc_template<__DEFAULT_ALLOC_INST, __default_size_classes, __mmap_chunk_source<true>>;
 
     // Initialization
-    char* __default_alloc::start_free = 0;
-    char* __default_alloc::end_free = 0;
-    size_t __default_alloc::heap_size = 0;
-    __default_alloc::obj* volatile __default_alloc::free_list[__NFREELISTS] =
-    { 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0 };
+    template<int inst, typename SizeClass, typename ChunkSource>
+    char* __default_alloc_template<inst, SizeClass, ChunkSource>::start_free = 0;
+    template<int inst, typename SizeClass, typename ChunkSource>
+    char* __default_alloc_template<inst, SizeClass, ChunkSource>::end_free = 0;
+    template<int inst, typename SizeClass, typename ChunkSource>
+    size_t __default_alloc_template<inst, SizeClass, ChunkSource>::heap_size = 0;
+    template<int inst, typename SizeClass, typename ChunkSource>
+    typename __default_alloc_template<inst, SizeClass, ChunkSource>::__chunk_header*
+    __default_alloc_template<inst, SizeClass, ChunkSource>::__chunks = 0;
+    template<int inst, typename SizeClass, typename ChunkSource>
+    size_t __default_alloc_template<inst, SizeClass, ChunkSource>::__idle_bytes = 0;
+    template<int inst, typename SizeClass, typename ChunkSource>
+    size_t __default_alloc_template<inst, SizeClass, ChunkSource>::__trim_threshold = 0;
+    template<int inst, typename SizeClass, typename ChunkSource>
+    size_t __default_alloc_template<inst, SizeClass, ChunkSource>::__next_trim_at = 0;
+    template<int inst, typename SizeClass, typename ChunkSource>
+    typename __default_alloc_template<inst, SizeClass, ChunkSource>::list_lock_type
+    __default_alloc_template<inst, SizeClass, ChunkSource>::__pool_lock;
+    template<int inst, typename SizeClass, typename ChunkSource>
+    typename __default_alloc_template<inst, SizeClass, ChunkSource>::chunk_lock_type
+    __default_alloc_template<inst, SizeClass, ChunkSource>::__chunk_lock;
+    template<int inst, typename SizeClass, typename ChunkSource>
+    typename __default_alloc_template<inst, SizeClass, ChunkSource>::free_list_type
+    __default_alloc_template<inst, SizeClass, ChunkSource>::free_list[SizeClass::nlists] = { };
+#ifdef __TOY_ALLOC_STATS
+    template<int inst, typename SizeClass, typename ChunkSource>
+    __alloc_counters<SizeClass::nlists> __default_alloc_template<inst, SizeClass, ChunkSource>::__counters;
+#endif
 
 }
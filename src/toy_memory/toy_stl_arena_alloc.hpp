@@ -0,0 +1,220 @@
+/*
+    Project:        Toy_STL_Arena_Alloc
+    Description:    request-scoped monotonic(bump) arena and its allocator
+    Update date:    2026/10/17
+    Author:         Zhuofan Zhang
+
+    Model:
+
+        __blocks --> | next | size | .... used .... | __cur    free    | __end
+                        |
+                        v
+                     | next | size | .......... used .......... |   (older, smaller)
+
+        allocate() bumps '__cur'; when the current block is full a new
+        block twice as big is chained in front. deallocate() does nothing:
+        memory only comes back with reset()/release() or the destructor.
+
+        The arena is a tmemory_resource as well, so tresource_allocator can
+        route a container to it; tarena_allocator skips the virtual call.
+*/
+#pragma once
+#include "toy_std.hpp"
+#include "toy_stl_alloc.hpp"
+#include "toy_stl_construct.hpp"
+#include "toyallocator.hpp"
+#include "toy_stl_resource.hpp"
+
+namespace toy_std
+{
+    class tmonotonic_arena : public tmemory_resource
+    {
+    public:
+        explicit tmonotonic_arena(size_t initial_size = 4096) :
+        __blocks(nullptr), __cur(nullptr), __end(nullptr),
+        __buffer(nullptr), __buffer_size(0), __next_size(initial_size < 64 ? 64 : initial_size)
+        { }
+
+        // Serve from 'buffer'(e.g. on the stack) first, then from the heap.
+        tmonotonic_arena(void* buffer, size_t bytes) :
+        __blocks(nullptr), __cur((char*)buffer), __end((char*)buffer + bytes),
+        __buffer((char*)buffer), __buffer_size(bytes), __next_size(bytes < 64 ? 64 : bytes)
+        { }
+
+        tmonotonic_arena(const tmonotonic_arena&) = delete;
+        tmonotonic_arena& operator=(const tmonotonic_arena&) = delete;
+
+        ~tmonotonic_arena() noexcept { release(); }
+
+        void* allocate(size_t bytes, size_t align = alignof(std::max_align_t))
+        {
+            char* p = __align_up(__cur, align);
+            if (p == nullptr || (size_t)(__end - p) < bytes)
+            {
+                __grow(bytes + align);
+                p = __align_up(__cur, align);
+            }
+            __cur = p + bytes;
+            return p;
+        }
+
+        // Monotonic: individual frees are no-ops.
+        void deallocate(void*, size_t) noexcept { }
+
+        /*
+            Rewind for the next request. The user buffer(if any) is reused
+            as is; otherwise only the newest(largest) block is kept.
+        */
+        void reset() noexcept
+        {
+            if (__buffer != nullptr)
+            {
+                __free_blocks(__blocks);
+                __blocks = nullptr;
+                __cur = __buffer;
+                __end = __buffer + __buffer_size;
+            }
+            else if (__blocks != nullptr)
+            {
+                __free_blocks(__blocks->next);
+                __blocks->next = nullptr;
+                __cur = __block_data(__blocks);
+                __end = (char*)__blocks + __blocks->size;
+            }
+        }
+
+        // Give every heap block back.
+        void release() noexcept
+        {
+            __free_blocks(__blocks);
+            __blocks = nullptr;
+            __cur = __buffer;
+            __end = __buffer + __buffer_size;
+        }
+
+    protected:
+        void* do_allocate(size_t bytes, size_t align) override { return allocate(bytes, align); }
+        void do_deallocate(void*, size_t, size_t) override { }
+
+    private:
+        struct __block
+        {
+            __block* next;
+            size_t size;    // including this header
+        };
+
+        __block* __blocks;
+        char* __cur;
+        char* __end;
+        char* __buffer;
+        size_t __buffer_size;
+        size_t __next_size;
+
+        static char* __align_up(char* p, size_t align)
+        {
+            return (char*)(((uintptr_t)p + align - 1) & ~(uintptr_t)(align - 1));
+        }
+
+        static char* __block_data(__block* b)
+        {
+            return __align_up((char*)(b + 1), alignof(std::max_align_t));
+        }
+
+        void __grow(size_t at_least)
+        {
+            size_t size = __next_size;
+            while (size < at_least + sizeof(__block) + alignof(std::max_align_t))
+                size <<= 1;
+            __block* b = (__block*)__malloc_alloc::allocate(size);
+            b->next = __blocks;
+            b->size = size;
+            __blocks = b;
+            __cur = __block_data(b);
+            __end = (char*)b + size;
+            __next_size = size << 1;
+        }
+
+        static void __free_blocks(__block* b) noexcept
+        {
+            while (b != nullptr)
+            {
+                __block* next = b->next;
+                __malloc_alloc::deallocate(b);
+                b = next;
+            }
+        }
+    };
+
+    /*
+        Allocator handing out memory of a tmonotonic_arena.
+        The containers take it like tallocator, e.g.
+
+            tmonotonic_arena arena;
+            tlist<int, tarena_allocator<__tList_Node<int>>> l(arena);
+
+        deallocate() is a no-op, so for trivially destructible elements
+        the containers skip the per-node teardown(see tallocator_traits).
+    */
+    template<typename T>
+    class tarena_allocator
+    {
+    public:
+        using value_type = T;
+        using pointer = T*;
+        using const_pointer = const T*;
+        using reference = T&;
+        using const_reference = const T&;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+        template<typename U>
+        struct rebind { using other = tarena_allocator<U>; };
+
+        /* Constructors */
+        tarena_allocator(tmonotonic_arena& arena) noexcept : __arena(&arena) { }
+
+        template<typename U>
+        tarena_allocator(const tarena_allocator<U>& other) noexcept : __arena(other.arena()) { }
+
+        pointer allocate(size_type n)
+        {
+            return (n == 0 ? nullptr : (pointer)__arena->allocate(n * sizeof(T), alignof(T)));
+        }
+        void deallocate(pointer, size_type) noexcept { }
+
+        void construct(pointer p, const_reference x) { toy_std::construct(p, x); }
+        void construct(pointer p, size_type n, const_pointer first)
+        {
+            for (size_t i = 0; i < n; ++i)
+                toy_std::construct(p + i, *(first + i));
+        }
+        void destroy(pointer p) { toy_std::destroy(p); }
+        size_type max_size() const { return tUINT_MAX / sizeof(T); }
+
+        tmonotonic_arena* arena() const noexcept { return __arena; }
+
+    private:
+        tmonotonic_arena* __arena;
+    };
+
+    template<typename T1, typename T2>
+    inline bool operator==(const tarena_allocator<T1>& a, const tarena_allocator<T2>& b) noexcept
+    {
+        return a.arena() == b.arena();
+    }
+
+    template<typename T1, typename T2>
+    inline bool operator!=(const tarena_allocator<T1>& a, const tarena_allocator<T2>& b) noexcept
+    {
+        return !(a == b);
+    }
+
+    // The arena travels with the nodes it holds on move and swap.
+    template<typename T>
+    struct tallocator_traits<tarena_allocator<T>> : __tallocator_traits_base<tarena_allocator<T>>
+    {
+        using has_trivial_deallocate = __true_type;
+        using propagate_on_container_move_assignment = __true_type;
+        using propagate_on_container_swap = __true_type;
+    };
+}
@@ -1,8 +1,10 @@
 /*
     Project:        Toy_STL_Construct
     Description:    build stl-like construct/destroy
-    Update date:    2019/2/22
+    Update date:    2026/10/17
     Author:         Zhuofan Zhang
+
+    Update Log:     2026/10/17 -- construct() forwards any constructor arguments.
 */
 #pragma once
 #include "toy_std.hpp"
@@ -12,6 +14,13 @@
 
 namespace toy_std
 {
+    // Build a T at 'p' from 'args': rvalues are moved in, not copied.
+    template <typename T, typename... Args>
+    inline void construct(T* p, Args&&... args) { ::new((void*)p) T(std::forward<Args>(args)...); }
+
+    // Declared ahead of __destroy_aux, which calls it for class types outside toy_std.
+    template <typename T> inline void destroy(T* p) { p->~T(); }
+
     template<typename ForwardIter, typename T>
     inline void __destroy(ForwardIter first, ForwardIter last, T*)
     {
@@ -29,10 +38,6 @@ namespace toy_std
             destroy(&*first);
     }
 
-    template <typename T1, typename T2> void construct(T1* p, const T2& value) { new(p) T1(value); }
-
-    template <typename T> inline void destroy(T* p) { p->~T(); }
-
     template<typename ForwardIter>
     inline void destroy(ForwardIter first, ForwardIter last)
     {
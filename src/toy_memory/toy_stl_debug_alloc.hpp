@@ -0,0 +1,258 @@
+/*
+    Project:        Toy_STL_Debug_Alloc
+    Description:    hardened wrapper of an allocator: size tags, redzones,
+                    poisoning, double-free and wrong-size-free detection
+    Update date:    2026/10/17
+    Author:         Zhuofan Zhang
+
+    Model(like SGI's debug_alloc, plus guards):
+
+        raw ---> | pad | size | state | offset |  user n bytes  | redzone |
+                                                ^
+                                                returned to the client
+
+        size    -- the 'n' asked for; deallocate(p, m) checks m == n
+        state   -- __DEBUG_LIVE / __DEBUG_FREED; anything else means the
+                   header was overwritten(underflow) or 'p' is foreign
+        redzone -- __DEBUG_REDZONE bytes of __DEBUG_GUARD_BYTE, checked on
+                   free(overflow)
+
+        Freed blocks are filled with __DEBUG_FREED_BYTE and parked in a small
+        per-thread quarantine(__TOY_ALLOC_DEBUG_QUARANTINE blocks, 0 turns it
+        off) before going back to 'Alloc', so a double free is still caught
+        after a few more frees, and a write after free shows up as a broken
+        fill when the block leaves the quarantine.
+
+        Errors go to the report handler: by default a message and a
+        backtrace on stderr, then abort(). tallocator switches to this
+        wrapper when '__TOY_ALLOC_DEBUG' is defined.
+*/
+#pragma once
+#include "toy_std.hpp"
+#include "toy_stl_alloc.hpp"
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <cstdlib>
+#if defined(__GLIBC__) || defined(__APPLE__)
+#include <execinfo.h>
+#endif
+
+#ifndef __TOY_ALLOC_DEBUG_QUARANTINE
+#define __TOY_ALLOC_DEBUG_QUARANTINE 64
+#endif
+
+namespace toy_std
+{
+    const uint32_t __DEBUG_LIVE = 0xA110CA7Eu;
+    const uint32_t __DEBUG_FREED = 0xDEADF7EEu;
+    const unsigned char __DEBUG_GUARD_BYTE = 0xFD;
+    const unsigned char __DEBUG_FREED_BYTE = 0xDD;
+    const size_t __DEBUG_REDZONE = 16;
+
+    // Message, the block, and a backtrace of the offending call.
+    inline void __debug_alloc_default_report(const char* what, const void* p)
+    {
+        fprintf(stderr, "toy_std debug allocator: %s (block %p)\n", what, p);
+#if defined(__GLIBC__) || defined(__APPLE__)
+        void* frames[32];
+        int n = backtrace(frames, 32);
+        backtrace_symbols_fd(frames, n, 2);
+#endif
+        abort();
+    }
+
+    template<typename Alloc>
+    class __debug_alloc_template
+    {
+    public:
+        using size_class = typename Alloc::size_class;
+        using report_handler = void (*)(const char* what, const void* p);
+
+    private:
+        struct __header
+        {
+            size_t size;
+            uint32_t state;
+            uint32_t offset;    // from the raw block to the client pointer
+        };
+
+        static const size_t __HEADER = 16;
+        static_assert(sizeof(__header) <= __HEADER, "debug header must fit in 16 bytes");
+
+        static __header* __header_of(void* p) { return (__header*)((char*)p - sizeof(__header)); }
+
+        static size_t __raw_size(size_t n, size_t offset) { return offset + n + __DEBUG_REDZONE; }
+
+        static void* __setup(char* raw, size_t n, size_t offset)
+        {
+            char* p = raw + offset;
+            __header* h = __header_of(p);
+            h->size = n;
+            h->state = __DEBUG_LIVE;
+            h->offset = (uint32_t)offset;
+            memset(p + n, __DEBUG_GUARD_BYTE, __DEBUG_REDZONE);
+            return p;
+        }
+
+        static bool __report(const char* what, const void* p)
+        {
+            __report_handler()(what, p);
+            return false;
+        }
+
+        // Every check of a free; false: already reported, drop the block.
+        static bool __check(void* p, size_t n)
+        {
+            __header* h = __header_of(p);
+            if (h->state == __DEBUG_FREED)
+                return __report("double free", p);
+            if (h->state != __DEBUG_LIVE)
+                return __report("free of a foreign pointer or header overwritten(underflow)", p);
+            if (h->size != n)
+            {
+                char msg[128];
+                snprintf(msg, sizeof(msg), "wrong-size free: allocated %zu bytes, freed as %zu", h->size, n);
+                return __report(msg, p);
+            }
+            const unsigned char* tail = (const unsigned char*)p + n;
+            for (size_t i = 0; i < __DEBUG_REDZONE; ++i)
+                if (tail[i] != __DEBUG_GUARD_BYTE)
+                    return __report("redzone overwritten(buffer overflow)", p);
+            return true;
+        }
+
+        static void __release(void* p)
+        {
+            __header* h = __header_of(p);
+            size_t offset = h->offset, n = h->size;
+            char* raw = (char*)p - offset;
+            if (offset == __HEADER)
+                Alloc::deallocate(raw, __raw_size(n, offset));
+            else
+                Alloc::deallocate_aligned(raw, __raw_size(n, offset), offset);
+        }
+
+        // Still filled with __DEBUG_FREED_BYTE when it leaves the quarantine?
+        static void __evict(void* p)
+        {
+            const unsigned char* q = (const unsigned char*)p;
+            size_t n = __header_of(p)->size;
+            for (size_t i = 0; i < n; ++i)
+                if (q[i] != __DEBUG_FREED_BYTE)
+                {
+                    __report("freed block written to(use after free)", p);
+                    return;
+                }
+            __release(p);
+        }
+
+#if __TOY_ALLOC_DEBUG_QUARANTINE > 0
+        struct __quarantine
+        {
+            void* blocks[__TOY_ALLOC_DEBUG_QUARANTINE];
+            size_t next;
+            size_t count;
+
+            __quarantine() : next(0), count(0) { }
+
+            // Park 'p', evicting the oldest block once full.
+            void push(void* p)
+            {
+                const size_t cap = __TOY_ALLOC_DEBUG_QUARANTINE;
+                if (count == cap)
+                    __evict(blocks[next]);
+                else
+                    ++count;
+                blocks[next] = p;
+                next = (next + 1) % cap;
+            }
+
+            ~__quarantine()
+            {
+                const size_t cap = __TOY_ALLOC_DEBUG_QUARANTINE;
+                for (size_t i = 0; i < count; ++i)
+                    __evict(blocks[(next + cap - count + i) % cap]);
+            }
+        };
+#endif
+
+        static void __free(void* p, size_t n)
+        {
+            if (!__check(p, n))
+                return;
+            __header_of(p)->state = __DEBUG_FREED;
+            memset(p, __DEBUG_FREED_BYTE, n);
+#if __TOY_ALLOC_DEBUG_QUARANTINE > 0
+            static thread_local __quarantine q;
+            q.push(p);
+#else
+            __release(p);
+#endif
+        }
+
+        static report_handler& __report_handler()
+        {
+            static report_handler handler = &__debug_alloc_default_report;
+            return handler;
+        }
+
+    public:
+        static void* allocate(size_t n)
+        {
+            return __setup((char*)Alloc::allocate(__raw_size(n, __HEADER)), n, __HEADER);
+        }
+
+        static void deallocate(void* p, size_t n)
+        {
+            if (p != 0)
+                __free(p, n);
+        }
+
+        // The header sits in front of the client pointer: pad it to 'align'.
+        static void* allocate_aligned(size_t n, size_t align)
+        {
+            if (align <= __HEADER)
+                return allocate(n);
+            return __setup((char*)Alloc::allocate_aligned(__raw_size(n, align), align), n, align);
+        }
+
+        static void deallocate_aligned(void* p, size_t n, size_t)
+        {
+            deallocate(p, n);
+        }
+
+        // Every block is checked on its own: no batching in debug mode.
+        static void allocate_batch(size_t n, size_t count, void** out)
+        {
+            size_t i = 0;
+            try
+            {
+                for (; i < count; ++i)
+                    out[i] = allocate(n);
+            }
+            catch (...)
+            {
+                deallocate_batch(n, i, out);
+                throw;
+            }
+        }
+
+        static void deallocate_batch(size_t n, size_t count, void** in)
+        {
+            for (size_t i = 0; i < count; ++i)
+                deallocate(in[i], n);
+        }
+
+        static size_t trim() { return Alloc::trim(); }
+        static void set_trim_threshold(size_t bytes) { Alloc::set_trim_threshold(bytes); }
+
+        // Replace the default report(abort). Returns the old handler.
+        static report_handler set_report_handler(report_handler f)
+        {
+            report_handler old = __report_handler();
+            __report_handler() = f;
+            return old;
+        }
+    };
+}
@@ -0,0 +1,362 @@
+/*
+    Project:        Toy_STL_NUMA_Alloc
+    Description:    one pool instance per NUMA node, picked by the calling thread
+    Update date:    2026/10/17
+    Author:         Zhuofan Zhang
+
+    Model:
+
+                       __numa_alloc::allocate(n)
+                                  |
+                     node of the calling thread(cached)
+                 ---------------------------------------
+                |                  |                    |
+        thread cache<0>    thread cache<1>    ...   thread cache<N-1>
+                |                  |                    |
+        __numa_node_alloc<0>  __numa_node_alloc<1>     ...
+                |                  |
+        __numa_chunk_source<0>  __numa_chunk_source<1>  -- chunks bound to
+                                                           their node(mbind)
+
+        Node discovery and binding:
+            __TOY_USE_LIBNUMA defined -- libnuma(numa_node_of_cpu, numa_alloc_onnode)
+            Linux                     -- getcpu/mbind system calls, node count
+                                         from /sys/devices/system/node/online
+            elsewhere                 -- a single node, plain malloc chunks
+
+        A thread's node is looked up once and cached; call
+        __numa_alloc::rebind_thread() after moving a thread to another node.
+
+        Chunks are __NUMA_GRANULE aligned and each granule's owner is kept
+        in __numa_page_map, so a free on any thread goes back to the pool
+        of the node the block came from: memory never changes node, and
+        that pool can trim the chunk later.
+*/
+#pragma once
+#include "toy_std.hpp"
+#include "toy_stl_alloc.hpp"
+#include "toy_stl_thread_alloc.hpp"
+#include <atomic>
+#include <utility>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#if defined(__TOY_USE_LIBNUMA)
+#include <numa.h>
+#include <sched.h>
+#elif defined(__linux__)
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif
+
+// Pool instances compiled in; nodes above it share pools(node % max).
+#ifndef __TOY_NUMA_MAX_NODES
+#define __TOY_NUMA_MAX_NODES 8
+#endif
+
+namespace toy_std
+{
+    const int __NUMA_ALLOC_INST = 16;   // instance of node 0; node k uses inst + k
+
+    /* Node discovery */
+#if defined(__TOY_USE_LIBNUMA)
+    inline int __numa_node_count()
+    {
+        static const int count = numa_available() < 0 ? 1 : numa_num_configured_nodes();
+        return count < 1 ? 1 : count;
+    }
+
+    inline int __numa_current_node()
+    {
+        int cpu = sched_getcpu();
+        int node = (numa_available() < 0 || cpu < 0) ? 0 : numa_node_of_cpu(cpu);
+        return node < 0 ? 0 : node;
+    }
+#elif defined(__linux__)
+    inline int __numa_node_count()
+    {
+        // "0" or "0-1" or "0,2-3": the last number is the highest node.
+        static const int count = []()
+        {
+            int last = 0;
+            FILE* f = fopen("/sys/devices/system/node/online", "r");
+            if (f != 0)
+            {
+                int c, n = -1;
+                while ((c = fgetc(f)) != EOF)
+                {
+                    if (c >= '0' && c <= '9')
+                        n = (n < 0 ? 0 : n * 10) + (c - '0');
+                    else if (n >= 0)
+                    {
+                        last = n;
+                        n = -1;
+                    }
+                }
+                if (n >= 0)
+                    last = n;
+                fclose(f);
+            }
+            return last + 1;
+        }();
+        return count;
+    }
+
+    inline int __numa_current_node()
+    {
+        unsigned cpu = 0, node = 0;
+        if (syscall(SYS_getcpu, &cpu, &node, (void*)0) != 0)
+            return 0;
+        return (int)node;
+    }
+#else
+    inline int __numa_node_count() { return 1; }
+    inline int __numa_current_node() { return 0; }
+#endif
+
+    // Node chunks are aligned to and sized in whole granules.
+    const size_t __NUMA_GRANULE_SHIFT = 16;
+    const size_t __NUMA_GRANULE = size_t(1) << __NUMA_GRANULE_SHIFT;
+
+    /*
+        Owner node of every chunk granule: a two-level radix map over
+        48-bit addresses. Leaves are allocated on first use and kept.
+        Addresses it can't hold(or malloc'd blocks) have no owner: -1.
+    */
+    class __numa_page_map
+    {
+        static const size_t __ADDRESS_BITS = 48;
+        static const size_t __LEAF_BITS = 16;
+        static const size_t __ROOT_BITS = __ADDRESS_BITS - __NUMA_GRANULE_SHIFT - __LEAF_BITS;
+
+        // Node + 1 per granule, 0: no owner.
+        struct __leaf
+        {
+            std::atomic<unsigned char> node[size_t(1) << __LEAF_BITS];
+        };
+
+        static std::atomic<__leaf*>* __root()
+        {
+            static std::atomic<__leaf*> root[size_t(1) << __ROOT_BITS];
+            return root;
+        }
+
+        static __leaf* __leaf_of(uintptr_t granule, bool create)
+        {
+            std::atomic<__leaf*>& slot = __root()[granule >> __LEAF_BITS];
+            __leaf* leaf = slot.load(std::memory_order_acquire);
+            if (leaf == 0 && create)
+            {
+                __leaf* fresh = (__leaf*)calloc(1, sizeof(__leaf));
+                if (fresh == 0)
+                    return 0;
+                if (slot.compare_exchange_strong(leaf, fresh, std::memory_order_acq_rel))
+                    leaf = fresh;
+                else
+                    free(fresh);
+            }
+            return leaf;
+        }
+
+        static void __mark(const void* p, size_t bytes, unsigned char value)
+        {
+            uintptr_t first = (uintptr_t)p >> __NUMA_GRANULE_SHIFT;
+            uintptr_t last = ((uintptr_t)p + bytes - 1) >> __NUMA_GRANULE_SHIFT;
+            if (bytes == 0 || (last >> (__ROOT_BITS + __LEAF_BITS)) != 0)
+                return;
+            for (uintptr_t g = first; g <= last; ++g)
+            {
+                __leaf* leaf = __leaf_of(g, value != 0);
+                if (leaf != 0)
+                    leaf->node[g & ((uintptr_t(1) << __LEAF_BITS) - 1)].store(value, std::memory_order_relaxed);
+            }
+        }
+
+    public:
+        static void set(const void* p, size_t bytes, int node) { __mark(p, bytes, (unsigned char)(node + 1)); }
+        static void clear(const void* p, size_t bytes) { __mark(p, bytes, 0); }
+
+        static int get(const void* p)
+        {
+            uintptr_t g = (uintptr_t)p >> __NUMA_GRANULE_SHIFT;
+            if ((g >> (__ROOT_BITS + __LEAF_BITS)) != 0)
+                return -1;
+            __leaf* leaf = __leaf_of(g, false);
+            if (leaf == 0)
+                return -1;
+            return int(leaf->node[g & ((uintptr_t(1) << __LEAF_BITS) - 1)].load(std::memory_order_relaxed)) - 1;
+        }
+    };
+
+    /*
+        Chunk source binding every chunk to 'Node'. The policy is
+        "preferred", so a full node spills over instead of failing, and
+        binding to a node the host doesn't have is simply skipped.
+    */
+#if defined(__TOY_USE_LIBNUMA) || defined(__linux__)
+    template<int Node>
+    struct __numa_chunk_source
+    {
+        using __pages = __mmap_chunk_source<false, __NUMA_GRANULE>;
+
+        static const size_t alignment = __pages::alignment;
+
+        static void* allocate(size_t& bytes)
+        {
+            void* p = __pages::allocate(bytes);
+            if (p == 0)
+                return 0;
+            __bind(p, bytes);
+            __numa_page_map::set(p, bytes, Node);
+            return p;
+        }
+        static void* oom_allocate(size_t& bytes)
+        {
+            void* p = __malloc_alloc::reclaim_and_retry([&bytes]() { return allocate(bytes); });
+            if (p == 0)
+                throw std::bad_alloc();
+            return p;
+        }
+        static void deallocate(void* p, size_t bytes)
+        {
+            __numa_page_map::clear(p, bytes);
+            __pages::deallocate(p, bytes);
+        }
+
+    private:
+        // Fresh mapping, nothing touched yet: the pages fault in on 'Node'.
+#if defined(__TOY_USE_LIBNUMA)
+        static void __bind(void* p, size_t bytes)
+        {
+            if (numa_available() >= 0 && Node < __numa_node_count())
+                numa_tonode_memory(p, bytes, Node);
+        }
+#else
+        static void __bind(void* p, size_t bytes)
+        {
+            if (__numa_node_count() > 1 && Node < __numa_node_count()
+                && Node < int(8 * sizeof(unsigned long)) - 1)
+            {
+                const int __MPOL_PREFERRED = 1;
+                unsigned long mask = 1UL << Node;
+                syscall(SYS_mbind, p, bytes, __MPOL_PREFERRED, &mask, 8 * sizeof(mask), 0);
+            }
+        }
+#endif
+    };
+#else
+    template<int Node>
+    struct __numa_chunk_source : public __malloc_chunk_source { };
+#endif
+
+    template<int Node>
+    using __numa_node_alloc =
+        __default_alloc_template<__NUMA_ALLOC_INST + Node, __default_size_classes, __numa_chunk_source<Node>>;
+
+    template<int Node>
+    using __numa_node_thread_alloc = __thread_cache_alloc_template<__numa_node_alloc<Node>>;
+
+    // Per-node entry points, so a runtime node number can pick its instance.
+    struct __numa_node_ops
+    {
+        void* (*allocate)(size_t);
+        void (*deallocate)(void*, size_t);
+        void* (*allocate_aligned)(size_t, size_t);
+        void (*deallocate_aligned)(void*, size_t, size_t);
+        size_t (*trim)();
+        void (*set_trim_threshold)(size_t);
+    };
+
+    template<int... Nodes>
+    struct __numa_node_table
+    {
+        static const __numa_node_ops* get(int node)
+        {
+            static const __numa_node_ops table[] = {
+                { &__numa_node_thread_alloc<Nodes>::allocate,
+                  &__numa_node_thread_alloc<Nodes>::deallocate,
+                  &__numa_node_thread_alloc<Nodes>::allocate_aligned,
+                  &__numa_node_thread_alloc<Nodes>::deallocate_aligned,
+                  &__numa_node_thread_alloc<Nodes>::trim,
+                  &__numa_node_thread_alloc<Nodes>::set_trim_threshold }...
+            };
+            return &table[node];
+        }
+    };
+
+    // __numa_node_table<0, 1, ..., N - 1>, built by hand to stay within C++11.
+    template<int N, int... Nodes>
+    struct __numa_node_table_of : __numa_node_table_of<N - 1, N - 1, Nodes...> { };
+
+    template<int... Nodes>
+    struct __numa_node_table_of<0, Nodes...>
+    {
+        using type = __numa_node_table<Nodes...>;
+    };
+
+    class __numa_alloc
+    {
+    public:
+        using size_class = __default_size_classes;
+
+    private:
+        using __table = typename __numa_node_table_of<__TOY_NUMA_MAX_NODES>::type;
+
+        static int __pools()
+        {
+            int n = __numa_node_count();
+            return n < __TOY_NUMA_MAX_NODES ? n : __TOY_NUMA_MAX_NODES;
+        }
+
+        static int& __thread_node()
+        {
+            static thread_local int node = -1;
+            return node;
+        }
+
+        static const __numa_node_ops* __ops()
+        {
+            int& node = __thread_node();
+            if (node < 0)
+                node = __numa_current_node() % __pools();
+            return __table::get(node);
+        }
+
+        // The pool that owns 'p'; malloc'd blocks may go through any of them.
+        static const __numa_node_ops* __owner_ops(const void* p)
+        {
+            int owner = __numa_page_map::get(p);
+            return owner >= 0 && owner < __TOY_NUMA_MAX_NODES ? __table::get(owner) : __ops();
+        }
+
+    public:
+        static void* allocate(size_t n) { return __ops()->allocate(n); }
+        static void deallocate(void* p, size_t n) { __owner_ops(p)->deallocate(p, n); }
+        static void* allocate_aligned(size_t n, size_t align) { return __ops()->allocate_aligned(n, align); }
+        static void deallocate_aligned(void* p, size_t n, size_t align) { __owner_ops(p)->deallocate_aligned(p, n, align); }
+
+        // Node the calling thread allocates from.
+        static int node() { return int(__ops() - __table::get(0)); }
+
+        // Node whose pool 'p' came from; -1 if it didn't come from one.
+        static int node_of(const void* p) { return __numa_page_map::get(p); }
+
+        // Look the calling thread's node up again(after it was migrated).
+        static void rebind_thread() { __thread_node() = -1; }
+
+        // Trim every node's pool(flushing only the calling thread's caches).
+        static size_t trim()
+        {
+            size_t released = 0;
+            for (int i = 0; i < __pools(); ++i)
+                released += __table::get(i)->trim();
+            return released;
+        }
+
+        static void set_trim_threshold(size_t bytes)
+        {
+            for (int i = 0; i < __pools(); ++i)
+                __table::get(i)->set_trim_threshold(bytes);
+        }
+    };
+}
@@ -0,0 +1,368 @@
+/*
+    Project:        Toy_STL_Object_Pool
+    Description:    typed slab pool for fixed-size objects(container nodes)
+    Update date:    2026/10/17
+    Author:         Zhuofan Zhang
+
+    Model:
+
+        __partial --> slab <--> slab <--> ...   (slabs with a free slot)
+        __full    --> slab <--> slab <--> ...   (slabs without one)
+
+        slab(SlabBytes, aligned to SlabBytes):
+
+            | header: links, free, bump, live, [bitmap] | slot | slot | ... |
+                                                          ^
+                                    free slots are chained through their
+                                    first word(intrusive free list)
+
+        The owning slab of an object is 'p & ~(SlabBytes - 1)', so a free
+        is O(1) with no lookup. Objects are served from the most recently
+        used partial slab, keeping a container's nodes packed together
+        instead of interleaved with unrelated pool blocks. One empty slab
+        is kept as a spare, the others go back to the system.
+
+        With 'Bitmap' every slab also keeps an occupancy bit per slot:
+        double frees are caught and reported(see toy_stl_debug_alloc.hpp).
+
+        Not thread-safe: a pool belongs to its container(s), like an arena.
+*/
+#pragma once
+#include "toy_std.hpp"
+#include "toytype_traits.hpp"
+#include "toy_stl_alloc.hpp"
+#include "toy_stl_construct.hpp"
+#include "toy_stl_debug_alloc.hpp"
+#include "toyallocator.hpp"
+#include <cstdint>
+
+namespace toy_std
+{
+    // Occupancy bits of a slab; nothing without 'Bitmap'.
+    template<bool Bitmap, size_t Slots>
+    struct __slab_bitmap
+    {
+        static const size_t words = (Slots + 63) / 64;
+        uint64_t bits[words];
+
+        void clear() { for (size_t i = 0; i < words; ++i) bits[i] = 0; }
+        void set(size_t i) { bits[i / 64] |= uint64_t(1) << (i % 64); }
+        // false: the bit was not set(double free).
+        bool reset(size_t i)
+        {
+            uint64_t mask = uint64_t(1) << (i % 64);
+            bool was = (bits[i / 64] & mask) != 0;
+            bits[i / 64] &= ~mask;
+            return was;
+        }
+    };
+
+    template<size_t Slots>
+    struct __slab_bitmap<false, Slots>
+    {
+        void clear() { }
+        void set(size_t) { }
+        bool reset(size_t) { return true; }
+    };
+
+    constexpr size_t __pow2_at_least(size_t n, size_t p = 1) { return p >= n ? p : __pow2_at_least(n, p << 1); }
+
+    template<typename T, bool Bitmap = false, size_t SlabBytes = 4096>
+    class tobject_pool
+    {
+    public:
+        using value_type = T;
+
+    private:
+        static const size_t __align = alignof(T) > alignof(void*) ? alignof(T) : alignof(void*);
+        static const size_t __slot = ((sizeof(T) > sizeof(void*) ? sizeof(T) : sizeof(void*)) + __align - 1) & ~(__align - 1);
+        // A page, or bigger so that a slab holds at least 16 objects.
+        static const size_t __slab_bytes = __pow2_at_least(SlabBytes > 16 * __slot ? SlabBytes : 16 * __slot);
+        static const size_t __max_slots = __slab_bytes / __slot;
+
+        struct __slab
+        {
+            __slab* next;       // partial list
+            __slab* prev;
+            void* free;         // intrusive list of freed slots
+            char* bump;         // first never-used slot
+            size_t live;
+            __slab_bitmap<Bitmap, __max_slots> bitmap;
+        };
+
+        static const size_t __header = (sizeof(__slab) + __align - 1) & ~(__align - 1);
+        static const size_t __slots = (__slab_bytes - __header) / __slot;
+
+        __slab* __partial;      // slabs with at least one free slot
+        __slab* __full;         // the others, so teardown still finds them
+        __slab* __spare;        // one empty slab kept back
+        size_t __nslabs;
+        size_t __live;
+
+        static __slab* __slab_of(const void* p)
+        {
+            return (__slab*)((uintptr_t)p & ~(uintptr_t)(__slab_bytes - 1));
+        }
+
+        static char* __first_slot(__slab* s) { return (char*)s + __header; }
+        static size_t __slot_index(__slab* s, const void* p) { return ((const char*)p - __first_slot(s)) / __slot; }
+
+        static void __unlink(__slab*& list, __slab* s)
+        {
+            if (s->prev != nullptr)
+                s->prev->next = s->next;
+            else
+                list = s->next;
+            if (s->next != nullptr)
+                s->next->prev = s->prev;
+        }
+
+        static void __push(__slab*& list, __slab* s)
+        {
+            s->prev = nullptr;
+            s->next = list;
+            if (list != nullptr)
+                list->prev = s;
+            list = s;
+        }
+
+        static void __free_list(__slab* s) noexcept
+        {
+            while (s != nullptr)
+            {
+                __slab* next = s->next;
+                __malloc_alloc::deallocate_aligned(s);
+                s = next;
+            }
+        }
+
+        __slab* __new_slab()
+        {
+            __slab* s = __spare;
+            if (s != nullptr)
+                __spare = nullptr;
+            else
+            {
+                s = (__slab*)__malloc_alloc::allocate_aligned(__slab_bytes, __slab_bytes);
+                ++__nslabs;
+            }
+            s->free = nullptr;
+            s->bump = __first_slot(s);
+            s->live = 0;
+            s->bitmap.clear();
+            __push(__partial, s);
+            return s;
+        }
+
+        void __release_slab(__slab* s)
+        {
+            __unlink(__partial, s);
+            if (__spare == nullptr)
+                __spare = s;
+            else
+            {
+                __malloc_alloc::deallocate_aligned(s);
+                --__nslabs;
+            }
+        }
+
+    public:
+        tobject_pool() noexcept : __partial(nullptr), __full(nullptr), __spare(nullptr), __nslabs(0), __live(0) { }
+
+        tobject_pool(const tobject_pool&) = delete;
+        tobject_pool& operator=(const tobject_pool&) = delete;
+
+        // Every slab is freed, full ones included; objects still live are not destroyed.
+        ~tobject_pool() noexcept
+        {
+            __free_list(__partial);
+            __free_list(__full);
+            if (__spare != nullptr)
+                __malloc_alloc::deallocate_aligned(__spare);
+        }
+
+        T* allocate()
+        {
+            __slab* s = __partial != nullptr ? __partial : __new_slab();
+            void* p;
+            if (s->free != nullptr)
+            {
+                p = s->free;
+                s->free = *(void**)p;
+            }
+            else
+            {
+                p = s->bump;
+                s->bump += __slot;
+            }
+            s->bitmap.set(__slot_index(s, p));
+            ++__live;
+            // Full: moves to the full list until something is freed.
+            if (++s->live == __slots)
+            {
+                __unlink(__partial, s);
+                __push(__full, s);
+            }
+            return (T*)p;
+        }
+
+        void deallocate(T* p) noexcept
+        {
+            __slab* s = __slab_of(p);
+            if (!s->bitmap.reset(__slot_index(s, p)))
+            {
+                __debug_alloc_default_report("tobject_pool: double free", p);
+                return;
+            }
+            *(void**)p = s->free;
+            s->free = p;
+            --__live;
+            if (s->live-- == __slots)
+            {
+                __unlink(__full, s);
+                __push(__partial, s);
+            }
+            else if (s->live == 0)
+                __release_slab(s);
+        }
+
+        void allocate_batch(size_t count, T** out)
+        {
+            size_t i = 0;
+            try
+            {
+                for (; i < count; ++i)
+                    out[i] = allocate();
+            }
+            catch (...)
+            {
+                deallocate_batch(i, out);
+                throw;
+            }
+        }
+
+        void deallocate_batch(size_t count, T** in) noexcept
+        {
+            for (size_t i = 0; i < count; ++i)
+                deallocate(in[i]);
+        }
+
+        size_t live() const noexcept { return __live; }
+        size_t slabs() const noexcept { return __nslabs; }
+        static constexpr size_t objects_per_slab() { return __slots; }
+    };
+
+    /*
+        Node allocator drawing single objects from a tobject_pool:
+
+            tobject_pool<__tList_Node<int>> pool;
+            tlist<int, tobject_pool_allocator<__tList_Node<int>>> l(pool);
+
+        Arrays(n != 1), rebound copies(e.g. a deque's map) and
+        default-constructed allocators go to tallocator.
+    */
+    template<typename T, bool Bitmap = false>
+    class tobject_pool_allocator
+    {
+    public:
+        using value_type = T;
+        using pointer = T*;
+        using const_pointer = const T*;
+        using reference = T&;
+        using const_reference = const T&;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using pool_type = tobject_pool<T, Bitmap>;
+
+        template<typename U>
+        struct rebind { using other = tobject_pool_allocator<U, Bitmap>; };
+
+        /* Constructors */
+        tobject_pool_allocator() noexcept : __pool(nullptr) { }
+        tobject_pool_allocator(pool_type& pool) noexcept : __pool(&pool) { }
+
+        tobject_pool_allocator(const tobject_pool_allocator& other) noexcept : __pool(other.__pool) { }
+
+        template<typename U>
+        tobject_pool_allocator(const tobject_pool_allocator<U, Bitmap>&) noexcept : __pool(nullptr) { }
+
+        tobject_pool_allocator& operator=(const tobject_pool_allocator& other) noexcept
+        {
+            __pool = other.__pool;
+            return *this;
+        }
+
+        pointer allocate(size_type n)
+        {
+            if (n == 1 && __pool != nullptr)
+                return __pool->allocate();
+            return __fallback.allocate(n);
+        }
+        void deallocate(pointer p, size_type n)
+        {
+            if (n == 1 && __pool != nullptr)
+                __pool->deallocate(p);
+            else
+                __fallback.deallocate(p, n);
+        }
+
+        void allocate_batch(size_type n, size_type count, pointer* out)
+        {
+            if (n == 1 && __pool != nullptr)
+                __pool->allocate_batch(count, out);
+            else
+                __fallback.allocate_batch(n, count, out);
+        }
+        void deallocate_batch(size_type n, size_type count, pointer* in)
+        {
+            if (n == 1 && __pool != nullptr)
+                __pool->deallocate_batch(count, in);
+            else
+                __fallback.deallocate_batch(n, count, in);
+        }
+
+        void construct(pointer p, const_reference x) { toy_std::construct(p, x); }
+        void construct(pointer p, size_type n, const_pointer first)
+        {
+            for (size_t i = 0; i < n; ++i)
+                toy_std::construct(p + i, *(first + i));
+        }
+        void destroy(pointer p) { toy_std::destroy(p); }
+        size_type max_size() const { return tUINT_MAX / sizeof(T); }
+
+        pool_type* pool() const noexcept { return __pool; }
+
+    private:
+        pool_type* __pool;
+        tallocator<T> __fallback;
+    };
+
+    template<typename T, bool B>
+    inline bool operator==(const tobject_pool_allocator<T, B>& a, const tobject_pool_allocator<T, B>& b) noexcept
+    {
+        return a.pool() == b.pool();
+    }
+
+    template<typename T, bool B>
+    inline bool operator!=(const tobject_pool_allocator<T, B>& a, const tobject_pool_allocator<T, B>& b) noexcept
+    {
+        return !(a == b);
+    }
+
+    // The pool travels with the nodes it holds on move and swap.
+    template<typename T, bool B>
+    struct tallocator_traits<tobject_pool_allocator<T, B>> : __tallocator_traits_base<tobject_pool_allocator<T, B>>
+    {
+        using propagate_on_container_move_assignment = __true_type;
+        using propagate_on_container_swap = __true_type;
+
+        static void allocate_batch(tobject_pool_allocator<T, B>& a, size_t n, size_t count, T** out)
+        {
+            a.allocate_batch(n, count, out);
+        }
+        static void deallocate_batch(tobject_pool_allocator<T, B>& a, size_t n, size_t count, T** in)
+        {
+            a.deallocate_batch(n, count, in);
+        }
+    };
+}
@@ -0,0 +1,139 @@
+/*
+    Project:        Toy_STL_Resource
+    Description:    memory resources and the stateful allocator bound to one
+    Update date:    2026/10/17
+    Author:         Zhuofan Zhang
+
+    Model:
+
+        tlist<int, tresource_allocator<__tList_Node<int>>>  a(&tenant_a);
+        tlist<int, tresource_allocator<__tList_Node<int>>>  b(&tenant_b);
+                            |                                  |
+                      tmemory_resource*                  tmemory_resource*
+                            |                                  |
+                  tpool_resource<__thread_alloc>     tmonotonic_arena / ...
+
+        Each allocator carries the resource it draws from, so two containers
+        of the same type can live in different pools, arenas or NUMA nodes.
+        Allocators compare equal when their resources do. The resource sticks
+        to its container: copies keep it, assignment and swap never move it
+        (the default tallocator_traits), so elements are copied across when
+        the two sides differ.
+*/
+#pragma once
+#include "toy_std.hpp"
+#include "toytype_traits.hpp"
+#include "toy_stl_construct.hpp"
+#include "toy_stl_thread_alloc.hpp"
+#include "toyallocator.hpp"
+
+namespace toy_std
+{
+    class tmemory_resource
+    {
+    public:
+        virtual ~tmemory_resource() { }
+
+        void* allocate(size_t bytes, size_t align = alignof(std::max_align_t))
+        {
+            return do_allocate(bytes, align);
+        }
+        void deallocate(void* p, size_t bytes, size_t align = alignof(std::max_align_t))
+        {
+            do_deallocate(p, bytes, align);
+        }
+        bool is_equal(const tmemory_resource& other) const noexcept
+        {
+            return this == &other || do_is_equal(other);
+        }
+
+    protected:
+        virtual void* do_allocate(size_t bytes, size_t align) = 0;
+        virtual void do_deallocate(void* p, size_t bytes, size_t align) = 0;
+        virtual bool do_is_equal(const tmemory_resource& other) const noexcept { return this == &other; }
+    };
+
+    /*
+        Adapter over one of the static pools(__default_alloc, __lockfree_alloc,
+        __thread_alloc, __hugepage_alloc ...). The pools already own global
+        state, so a single instance per pool is enough.
+    */
+    template<typename Pool>
+    class tpool_resource : public tmemory_resource
+    {
+    public:
+        static tpool_resource* instance() noexcept
+        {
+            static tpool_resource __instance;
+            return &__instance;
+        }
+
+    protected:
+        void* do_allocate(size_t bytes, size_t align) override { return Pool::allocate_aligned(bytes, align); }
+        void do_deallocate(void* p, size_t bytes, size_t align) override { Pool::deallocate_aligned(p, bytes, align); }
+    };
+
+    inline tmemory_resource* tdefault_resource() noexcept
+    {
+        return tpool_resource<__thread_alloc>::instance();
+    }
+
+    template<typename T>
+    class tresource_allocator
+    {
+    public:
+        using value_type = T;
+        using pointer = T*;
+        using const_pointer = const T*;
+        using reference = T&;
+        using const_reference = const T&;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+        template<typename U>
+        struct rebind { using other = tresource_allocator<U>; };
+
+        /* Constructors */
+        tresource_allocator() noexcept : __resource(tdefault_resource()) { }
+        tresource_allocator(tmemory_resource* r) noexcept : __resource(r) { }
+
+        template<typename U>
+        tresource_allocator(const tresource_allocator<U>& other) noexcept : __resource(other.resource()) { }
+
+        pointer allocate(size_type n)
+        {
+            return (n == 0 ? nullptr : (pointer)__resource->allocate(n * sizeof(T), alignof(T)));
+        }
+        void deallocate(pointer p, size_type n)
+        {
+            if (p != nullptr)
+                __resource->deallocate(p, n * sizeof(T), alignof(T));
+        }
+
+        void construct(pointer p, const_reference x) { toy_std::construct(p, x); }
+        void construct(pointer p, size_type n, const_pointer first)
+        {
+            for (size_t i = 0; i < n; ++i)
+                toy_std::construct(p + i, *(first + i));
+        }
+        void destroy(pointer p) { toy_std::destroy(p); }
+        size_type max_size() const { return tUINT_MAX / sizeof(T); }
+
+        tmemory_resource* resource() const noexcept { return __resource; }
+
+    private:
+        tmemory_resource* __resource;
+    };
+
+    template<typename T1, typename T2>
+    inline bool operator==(const tresource_allocator<T1>& a, const tresource_allocator<T2>& b) noexcept
+    {
+        return a.resource()->is_equal(*b.resource());
+    }
+
+    template<typename T1, typename T2>
+    inline bool operator!=(const tresource_allocator<T1>& a, const tresource_allocator<T2>& b) noexcept
+    {
+        return !(a == b);
+    }
+}
@@ -0,0 +1,258 @@
+/*
+    Project:        Toy_STL_Thread_Alloc
+    Description:    per-thread magazine caches in front of the sub-allocator
+    Update date:    2026/10/17
+    Author:         Zhuofan Zhang
+
+    Model:
+
+        thread 1 ----                          ---- thread 2
+                     |                        |
+         [ magazine x nlists ]      [ magazine x nlists ]
+                     |                        |
+                     |  __take_batch          |
+                     |  __give_batch          |
+                      ------> Pool <----------
+                     (__default_alloc or __lockfree_alloc)
+
+        Every size class owns a magazine of up to '__MAGAZINE_ROUNDS' blocks
+        (fewer for the big classes, see __magazine_capacity).
+        allocate/deallocate only touch the magazine of the calling thread;
+        an empty magazine is refilled with half a magazine from the pool
+        and a full one sends half of its rounds back, so the pool lock is
+        taken once per 'capacity / 2' operations at most.
+*/
+#pragma once
+#include "toy_std.hpp"
+#include "toy_stl_alloc.hpp"
+
+namespace toy_std
+{
+    const int __MAGAZINE_ROUNDS = 32;
+
+    template<typename Pool>
+    class __thread_cache_alloc_template
+    {
+    public:
+        using size_class = typename Pool::size_class;
+
+    private:
+
+        // Cap the bytes a single magazine may hold at 32 linear-class blocks.
+        static int __magazine_capacity(size_t size)
+        {
+            size_t cap = __MAGAZINE_ROUNDS * size_class::linear_bytes / size;
+            if (cap > size_t(__MAGAZINE_ROUNDS))
+                cap = __MAGAZINE_ROUNDS;
+            return cap < 4 ? 4 : int(cap) & ~1;
+        }
+
+        struct __magazine
+        {
+            int count;
+            int capacity;
+            void* rounds[__MAGAZINE_ROUNDS];
+        };
+
+        /*
+            Lifetime of the calling thread's rack, kept outside it: a plain
+            thread_local char is constant-initialized and never destroyed,
+            so it can still be read once the rack itself is gone.
+        */
+        static const unsigned char __RACK_UNBUILT = 0;
+        static const unsigned char __RACK_ALIVE = 1;
+        static const unsigned char __RACK_DEAD = 2;
+
+        static unsigned char& __rack_state()
+        {
+            static thread_local unsigned char state = __RACK_UNBUILT;
+            return state;
+        }
+
+        struct __magazine_rack
+        {
+            __magazine mags[size_class::nlists];
+
+            __magazine_rack()
+            {
+                for (size_t i = 0; i < size_class::nlists; ++i)
+                {
+                    mags[i].count = 0;
+                    mags[i].capacity = __magazine_capacity(size_class::size_of(i));
+                }
+                __rack_state() = __RACK_ALIVE;
+            }
+
+            // Thread exit: hand every cached block back to the pool.
+            ~__magazine_rack()
+            {
+                for (size_t i = 0; i < size_class::nlists; ++i)
+                {
+                    Pool::__give_batch(size_class::size_of(i), mags[i].count, mags[i].rounds);
+                    mags[i].count = 0;
+                }
+                __rack_state() = __RACK_DEAD;
+            }
+        };
+
+        /*
+            Function-local: a thread_local static data member of a class
+            template leaves the rack's destructor uninstantiated(GCC) when
+            the only user is a virtual function(e.g. tpool_resource).
+        */
+        static __magazine_rack& __rack()
+        {
+            static thread_local __magazine_rack rack;
+            return rack;
+        }
+
+        /*
+            0 once this thread's rack is destroyed: a destructor running
+            after it(e.g. of a static container) goes straight to the pool.
+        */
+        static __magazine_rack* __live_rack()
+        {
+            return __rack_state() == __RACK_DEAD ? 0 : &__rack();
+        }
+
+        static size_t MAGAZINE_INDEX(size_t bytes)
+        {
+            return size_class::index(bytes);
+        }
+
+    public:
+        static void* allocate(size_t n)
+        {
+            if (n > size_class::max_bytes)
+                return __malloc_alloc::allocate(n);
+
+            __magazine_rack* rack = __live_rack();
+            if (rack == 0)
+                return Pool::allocate(n);
+
+            __magazine& mag = rack->mags[MAGAZINE_INDEX(n)];
+            if (mag.count == 0)
+                mag.count = Pool::__take_batch(n, mag.capacity / 2, mag.rounds);
+            return mag.rounds[--mag.count];
+        }
+
+        static void deallocate(void* p, size_t n)
+        {
+            if (n > size_class::max_bytes)
+            {
+                __malloc_alloc::deallocate(p);
+                return;
+            }
+
+            __magazine_rack* rack = __live_rack();
+            if (rack == 0)
+            {
+                Pool::deallocate(p, n);
+                return;
+            }
+
+            __magazine& mag = rack->mags[MAGAZINE_INDEX(n)];
+            if (mag.count == mag.capacity)
+            {
+                // Full: keep the most recently freed(hot) half.
+                int half = mag.capacity / 2;
+                Pool::__give_batch(n, half, mag.rounds);
+                for (int i = 0; i < half; ++i)
+                    mag.rounds[i] = mag.rounds[i + half];
+                mag.count = half;
+            }
+            mag.rounds[mag.count++] = p;
+        }
+
+        /*
+            Bulk versions: the magazine is used first, whatever is left
+            goes to the pool in one batch instead of a refill per round.
+        */
+        static void allocate_batch(size_t n, size_t count, void** out)
+        {
+            size_t taken = 0;
+            if (n <= size_class::max_bytes)
+            {
+                __magazine_rack* rack = __live_rack();
+                if (rack != 0)
+                {
+                    __magazine& mag = rack->mags[MAGAZINE_INDEX(n)];
+                    while (taken < count && mag.count > 0)
+                        out[taken++] = mag.rounds[--mag.count];
+                }
+            }
+            try
+            {
+                Pool::allocate_batch(n, count - taken, out + taken);
+            }
+            catch (...)
+            {
+                // The pool kept nothing; the magazine rounds go back too.
+                deallocate_batch(n, taken, out);
+                throw;
+            }
+        }
+
+        static void deallocate_batch(size_t n, size_t count, void** in)
+        {
+            if (n <= size_class::max_bytes)
+            {
+                __magazine_rack* rack = __live_rack();
+                if (rack != 0)
+                {
+                    __magazine& mag = rack->mags[MAGAZINE_INDEX(n)];
+                    while (count > 0 && mag.count < mag.capacity)
+                    {
+                        mag.rounds[mag.count++] = *in++;
+                        --count;
+                    }
+                }
+            }
+            Pool::deallocate_batch(n, count, in);
+        }
+
+        // Same contract as Pool::allocate_aligned; served from the magazines.
+        static void* allocate_aligned(size_t n, size_t align)
+        {
+            if (align <= size_class::align)
+                return allocate(n);
+            size_t size = size_class::aligned_size(n, align);
+            return size != 0 ? allocate(size) : __malloc_alloc::allocate_aligned(n, align);
+        }
+
+        static void deallocate_aligned(void* p, size_t n, size_t align)
+        {
+            if (align <= size_class::align)
+            {
+                deallocate(p, n);
+                return;
+            }
+            size_t size = size_class::aligned_size(n, align);
+            if (size != 0)
+                deallocate(p, size);
+            else
+                __malloc_alloc::deallocate_aligned(p);
+        }
+
+        /*
+            Flush the calling thread's magazines, then trim the pool.
+            Other threads' magazines still pin the chunks they cache from.
+        */
+        static size_t trim()
+        {
+            __magazine_rack* rack = __live_rack();
+            if (rack != 0)
+                for (size_t i = 0; i < size_class::nlists; ++i)
+                {
+                    Pool::__give_batch(size_class::size_of(i), rack->mags[i].count, rack->mags[i].rounds);
+                    rack->mags[i].count = 0;
+                }
+            return Pool::trim();
+        }
+
+        static void set_trim_threshold(size_t bytes) { Pool::set_trim_threshold(bytes); }
+    };
+
+    using __thread_alloc = __thread_cache_alloc_template<__default_alloc>;
+    using __lockfree_thread_alloc = __thread_cache_alloc_template<__lockfree_alloc>;
+}
@@ -5,6 +5,7 @@
 
     Update Log:     2019/12/15 -- Try to finish the different types(unfinished, need to implement the 'copy'/'fill' functions)
                     2019/12/16 -- Implement 'copy/fill/fill_n' in <toyalgo_base.hpp>; temporarily removed 'uninitialized_copy_n'
+                    2026/10/17 -- Add '__uninitialized_relocate'(for tvector/tsmall_vector).
 
 */
 #pragma once
@@ -12,6 +13,9 @@
 #include"toyiterator.hpp"
 #include"toytype_traits.hpp"
 #include"toyalgo_base.hpp"
+#include"toy_stl_construct.hpp"
+#include<cstring>
+#include<utility>
 
 namespace toy_std
 {
@@ -117,6 +121,45 @@ namespace toy_std
 
     
 
+    /*
+        Relocate: move [first, last) into raw memory at 'result' and end the
+        lifetime of the originals; returns the end of the new range.
+        POD types are memcpy'd, others are moved(copied when the move may
+        throw) and destroyed. If a copy throws, the source is left intact.
+    */
+    template<typename T>
+    inline T* __uninitialized_relocate_aux(T* first, T* last, T* result, __true_type) noexcept
+    {
+        if (first != last)
+            memcpy((void*)result, (const void*)first, (last - first) * sizeof(T));
+        return result + (last - first);
+    }
+
+    template<typename T>
+    T* __uninitialized_relocate_aux(T* first, T* last, T* result, __false_type)
+    {
+        T* cur = result;
+        try
+        {
+            for (T* p = first; p != last; ++p, ++cur)
+                ::new((void*)cur) T(std::move_if_noexcept(*p));
+        }
+        catch (...)
+        {
+            toy_std::destroy(result, cur);
+            throw;
+        }
+        toy_std::destroy(first, last);
+        return cur;
+    }
+
+    template<typename T>
+    inline T* __uninitialized_relocate(T* first, T* last, T* result)
+    {
+        using is_POD = typename __type_traits<T>::is_POD_type;
+        return __uninitialized_relocate_aux(first, last, result, is_POD());
+    }
+
 /* Memory manage tools */
 
     template<typename InputIterator, typename ForwardIterator>
@@ -1,15 +1,94 @@
 /*
     Project:        Toy_Allocator
-    Update date:    2020/3/2
+    Update date:    2026/10/17
     Author:         Zhuofan Zhang
 */
 #pragma once
 #include"toy_std.hpp"
-#include "toymemory.hpp"
+#include "toytype_traits.hpp"
+#include "toy_stl_construct.hpp"
+#include "toy_stl_thread_alloc.hpp"
+#include "toy_stl_debug_alloc.hpp"
 
 
 namespace toy_std
 {
+    /*
+        Extra facts the containers need about an allocator.
+        has_trivial_deallocate: deallocate() is a no-op(arena allocators),
+                                so node teardown can be skipped.
+        propagate_on_container_*: whether the allocator follows the
+                                elements on copy-assignment, move-assignment
+                                and swap; otherwise it stays with the container.
+        is_always_equal:        any two instances can free each other's memory.
+        Defaults fit a stateful allocator; specializations derive from
+        '__tallocator_traits_base' and override what differs.
+    */
+    template<typename Alloc>
+    struct __tallocator_traits_base
+    {
+        using has_trivial_deallocate = __false_type;
+        using propagate_on_container_copy_assignment = __false_type;
+        using propagate_on_container_move_assignment = __false_type;
+        using propagate_on_container_swap = __false_type;
+        using is_always_equal = __false_type;
+
+        static Alloc select_on_container_copy_construction(const Alloc& a) { return a; }
+
+        // Bulk node allocation; one call per block unless the allocator batches.
+        // All or nothing: if it throws, the blocks already taken are given back.
+        template<typename Pointer>
+        static void allocate_batch(Alloc& a, size_t n, size_t count, Pointer* out)
+        {
+            size_t i = 0;
+            try
+            {
+                for (; i < count; ++i)
+                    out[i] = a.allocate(n);
+            }
+            catch (...)
+            {
+                while (i > 0)
+                    a.deallocate(out[--i], n);
+                throw;
+            }
+        }
+        template<typename Pointer>
+        static void deallocate_batch(Alloc& a, size_t n, size_t count, Pointer* in)
+        {
+            for (size_t i = 0; i < count; ++i)
+                a.deallocate(in[i], n);
+        }
+    };
+
+    template<typename Alloc>
+    struct tallocator_traits : __tallocator_traits_base<Alloc> { };
+
+    template<typename Alloc>
+    inline bool __allocator_equal(const Alloc&, const Alloc&, __true_type) noexcept { return true; }
+
+    template<typename Alloc>
+    inline bool __allocator_equal(const Alloc& a, const Alloc& b, __false_type) noexcept { return a == b; }
+
+    // Can memory from 'a' be given back through 'b'?
+    template<typename Alloc>
+    inline bool __allocator_equal(const Alloc& a, const Alloc& b) noexcept
+    {
+        using always_equal = typename tallocator_traits<Alloc>::is_always_equal;
+        return __allocator_equal(a, b, always_equal());
+    }
+
+    /*
+        What tallocator draws from: the per-thread magazines over
+        '__default_alloc', or, with '__TOY_ALLOC_DEBUG', the same behind
+        the hardened wrapper(toy_stl_debug_alloc.hpp).
+    */
+#ifdef __TOY_ALLOC_DEBUG
+    using __tallocator_backend = __debug_alloc_template<__thread_alloc>;
+#else
+    using __tallocator_backend = __thread_alloc;
+#endif
+
     template<typename T>
     class tallocator
     {
@@ -22,14 +101,15 @@ namespace toy_std
         using size_type = std::size_t;
         using difference_type = std::ptrdiff_t;
 
-        // template<typename T1, typename T2>
-        // friend bool operator==(const tallocator<T1>&, const tallocator<T2>&) noexcept;
+        template<typename U>
+        struct rebind { using other = tallocator<U>; };
 
         /* Constants */
         static const size_type __max_size = tUINT_MAX;
 
     private:
-        __default_alloc __alloc;
+        // Safe to use from any thread(see __tallocator_backend).
+        __tallocator_backend __alloc;
 
     public:
         /* Constructors */
@@ -40,12 +120,12 @@ namespace toy_std
         { 
           /* 
              Do nothing. 
-             Because there's no non-static object in __default_alloc 
+             Because there's no non-static object in the backend 
           */ 
         }
 
-        // template<typename U>
-        // tallocator(tallocator<U>&) noexcept;
+        template<typename U>
+        tallocator(const tallocator<U>&) noexcept { }
 
         /* Destructor */
         ~tallocator() noexcept { } ;
@@ -54,25 +134,96 @@ namespace toy_std
 
         pointer allocate(size_type);
         void deallocate(pointer, size_type);
+        // 'count' blocks of 'n' objects each, in a few pool round trips.
+        void allocate_batch(size_type n, size_type count, pointer* out);
+        void deallocate_batch(size_type n, size_type count, pointer* in);
         void construct(pointer, const_reference);
         void construct(pointer, size_type, const_pointer);
         void destroy(pointer);
-        size_type max_size() { return __max_size; }
+        size_type max_size() const { return __max_size; }
 
     };
 
+    // All tallocators share the same pools.
+    template<typename T1, typename T2>
+    inline bool operator==(const tallocator<T1>&, const tallocator<T2>&) noexcept { return true; }
+
+    template<typename T1, typename T2>
+    inline bool operator!=(const tallocator<T1>&, const tallocator<T2>&) noexcept { return false; }
+
+    template<typename T>
+    struct tallocator_traits<tallocator<T>> : __tallocator_traits_base<tallocator<T>>
+    {
+        using propagate_on_container_move_assignment = __true_type;
+        using is_always_equal = __true_type;
+
+        static void allocate_batch(tallocator<T>& a, size_t n, size_t count, T** out)
+        {
+            a.allocate_batch(n, count, out);
+        }
+        static void deallocate_batch(tallocator<T>& a, size_t n, size_t count, T** in)
+        {
+            a.deallocate_batch(n, count, in);
+        }
+    };
+
     template<typename T>
     typename tallocator<T>::pointer
         tallocator<T>::allocate(size_type n)
     {
-        return (n == 0 ? nullptr : (pointer)__alloc.allocate(n * sizeof(T)));
+        if (n == 0)
+            return nullptr;
+        // Over-aligned T(e.g. alignas(64) SIMD blocks): pick a class aligned enough.
+        if (alignof(T) > __tallocator_backend::size_class::align)
+            return (pointer)__alloc.allocate_aligned(n * sizeof(T), alignof(T));
+        return (pointer)__alloc.allocate(n * sizeof(T));
     }
 
     template<typename T>
     void
         tallocator<T>::deallocate(pointer p, size_type n)
     {
-        __alloc.deallocate(p, n * sizeof(T));
+        if (alignof(T) > __tallocator_backend::size_class::align)
+            __alloc.deallocate_aligned(p, n * sizeof(T), alignof(T));
+        else
+            __alloc.deallocate(p, n * sizeof(T));
+    }
+
+    template<typename T>
+    void
+        tallocator<T>::allocate_batch(size_type n, size_type count, pointer* out)
+    {
+        if (n == 0 || alignof(T) > __tallocator_backend::size_class::align)
+        {
+            // All or nothing, like the batched path.
+            size_type i = 0;
+            try
+            {
+                for (; i < count; ++i)
+                    out[i] = allocate(n);
+            }
+            catch (...)
+            {
+                while (i > 0)
+                    deallocate(out[--i], n);
+                throw;
+            }
+            return;
+        }
+        __alloc.allocate_batch(n * sizeof(T), count, (void**)out);
+    }
+
+    template<typename T>
+    void
+        tallocator<T>::deallocate_batch(size_type n, size_type count, pointer* in)
+    {
+        if (n == 0 || alignof(T) > __tallocator_backend::size_class::align)
+        {
+            for (size_type i = 0; i < count; ++i)
+                deallocate(in[i], n);
+            return;
+        }
+        __alloc.deallocate_batch(n * sizeof(T), count, (void**)in);
     }
 
     template<typename T>
@@ -1,6 +1,12 @@
 #pragma once
 #include "toy_stl_construct.hpp"
 #include "toy_stl_alloc.hpp"
+#include "toy_stl_thread_alloc.hpp"
+#include "toy_stl_debug_alloc.hpp"
 #include "toy_stl_uninitialized.hpp"
 #include "toyallocator.hpp"
+#include "toy_stl_resource.hpp"
+#include "toy_stl_numa_alloc.hpp"
+#include "toy_stl_arena_alloc.hpp"
+#include "toy_stl_object_pool.hpp"
 
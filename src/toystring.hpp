@@ -1,7 +1,7 @@
 /*
 	Project:        Toy_String
 	Description:    Build a practice-aimed toy-module in C++
-	Update date:    2019/12/14
+	Update date:    2026/10/17
 	Author:         Zhuofan Zhang
 
 	Update Log:     2019/11/13 -- replaced the former version with 'allocator version'.
@@ -11,6 +11,8 @@
 					2019/11/22 -- Add Exceptions process.
 					2019/11/24 -- Add moving constructor/ moving =
 					2019/12/14 -- Add overload of >>; replace the <cstring> function with "toycstring".
+					2026/10/17 -- Add allocator-taking constructors(e.g. for tarena_allocator).
+					2026/10/17 -- Honour tallocator_traits on copy/move/swap(stateful allocators).
 
 
 	Model:
@@ -35,6 +37,9 @@
 #pragma once
 #include"toy_std.hpp"
 #include"toycstring.hpp"
+#include"toytype_traits.hpp"
+#include"toyallocator.hpp"
+#include<memory>
 using std::ostream;
 using std::istream;
 using std::uninitialized_copy;
@@ -85,8 +90,7 @@ namespace toy_std
 		template<typename X, typename A>
 		friend bool operator==(const tbasic_string<X, A>&, const tbasic_string<X, A>&);
 
-		template<typename X, typename A>
-		friend bool operator!=(const tbasic_string<X, A>& a, const tbasic_string<X, A>& b) { return !(a == b); }
+		friend bool operator!=(const tbasic_string& a, const tbasic_string& b) { return !(a == b); }
 
 		template<typename X, typename A>
 		friend bool operator<(const tbasic_string<X, A>&, const tbasic_string<X, A>&);
@@ -94,38 +98,80 @@ namespace toy_std
 		template<typename X, typename A>
 		friend bool operator>(const tbasic_string<X, A>&, const tbasic_string<X, A>&);
 
-		template<typename X, typename A>
-		friend bool operator<=(const tbasic_string<X, A>& a, const tbasic_string<X, A>& b) { return !(a > b); }
+		friend bool operator<=(const tbasic_string& a, const tbasic_string& b) { return !(a > b); }
 
-		template<typename X, typename A>
-		friend bool operator>=(const tbasic_string<X, A>& a, const tbasic_string<X, A>& b) { return !(a < b); }
+		friend bool operator>=(const tbasic_string& a, const tbasic_string& b) { return !(a < b); }
 
 
 	private:
+		// '_alloc' goes first: '_data' is allocated from it in the initializers.
+		allocator_type _alloc;
 		size_type _capability;
 		size_type _length;
 
 		iterator _data;
-		allocator_type _alloc;
 
 
 		/* Remove */
 		void _do_destroy();
 
+		/* Allocator propagation(see tallocator_traits) */
+		using _alloc_traits = tallocator_traits<Allocator>;
+
+		const allocator_type& _assign_alloc(const tbasic_string<CharType, Allocator>& t, __true_type) { return t._alloc; }
+		const allocator_type& _assign_alloc(const tbasic_string<CharType, Allocator>&, __false_type) { return _alloc; }
+
+		void _swap_all(tbasic_string<CharType, Allocator>& str) noexcept
+		{
+			std::swap(_alloc, str._alloc);
+			std::swap(_data, str._data);
+			std::swap(_length, str._length);
+			std::swap(_capability, str._capability);
+		}
+
+		void _swap_alloc(tbasic_string<CharType, Allocator>& str, __true_type) { std::swap(_alloc, str._alloc); }
+		void _swap_alloc(tbasic_string<CharType, Allocator>&, __false_type) { }
+
+		void _steal(tbasic_string<CharType, Allocator>& rt) noexcept
+		{
+			_do_destroy();
+			_data = rt._data;
+			_length = rt._length;
+			_capability = rt._capability;
+			rt._data = nullptr;
+			rt._length = rt._capability = 0;
+		}
+
+		void _move_assign(tbasic_string<CharType, Allocator>& rt, __true_type) noexcept
+		{
+			_do_destroy();
+			_alloc = rt._alloc;
+			_steal(rt);
+		}
+		void _move_assign(tbasic_string<CharType, Allocator>& rt, __false_type)
+		{
+			// The buffer may only change hands between equal allocators.
+			if (__allocator_equal(_alloc, rt._alloc))
+				_steal(rt);
+			else
+				*this = static_cast<const tbasic_string<CharType, Allocator>&>(rt);
+		}
+
 
 
 	public:
 		/* Constructors */
 		tbasic_string();
-		tbasic_string(const_iterator);
-		tbasic_string(const_iterator, const_iterator);
-		tbasic_string(size_type, const char);
+		explicit tbasic_string(const Allocator&);
+		tbasic_string(const_iterator, const Allocator& = Allocator());
+		tbasic_string(const_iterator, const_iterator, const Allocator& = Allocator());
+		tbasic_string(size_type, const char, const Allocator& = Allocator());
 		tbasic_string(const tbasic_string<CharType, Allocator>&);
-		tbasic_string(const tbasic_string<CharType, Allocator>&&) noexcept;
+		tbasic_string(tbasic_string<CharType, Allocator>&&) noexcept;
 		tbasic_string<CharType, Allocator>& operator=(const tbasic_string<CharType, Allocator>&);
 		tbasic_string<CharType, Allocator>& operator=(const_iterator);
-		tbasic_string<CharType, Allocator>& operator=(const tbasic_string<CharType, Allocator>&&) noexcept;
-		tbasic_string(initializer_list<value_type>);
+		tbasic_string<CharType, Allocator>& operator=(tbasic_string<CharType, Allocator>&&) noexcept;
+		tbasic_string(initializer_list<value_type>, const Allocator& = Allocator());
 
 
 		/* Destructor */
@@ -175,6 +221,8 @@ namespace toy_std
 
 		tbasic_string<CharType, Allocator> substr(size_type, size_type);
 
+		allocator_type get_allocator() const { return _alloc; }
+
 		tbasic_string<CharType, Allocator>& append(const tbasic_string<CharType, Allocator>&);
 		tbasic_string<CharType, Allocator>& append(const_iterator);
 
@@ -264,31 +312,38 @@ namespace toy_std
 	}
 
 	template<typename CharType, typename Allocator >
-	tbasic_string<CharType, Allocator>::tbasic_string(size_type len, const char s) :
-		_alloc(), _capability(len << 1), _length(len), _data(_alloc.allocate(_capability + 1))
+	tbasic_string<CharType, Allocator>::tbasic_string(const Allocator& alloc) :
+		_alloc(alloc), _capability(_default_capability), _length(0), _data(_alloc.allocate(_capability + 1))
+	{
+		_alloc.construct(_data, '\0');
+	}
+
+	template<typename CharType, typename Allocator >
+	tbasic_string<CharType, Allocator>::tbasic_string(size_type len, const char s, const Allocator& alloc) :
+		_alloc(alloc), _capability(len << 1), _length(len), _data(_alloc.allocate(_capability + 1))
 	{
 		_alloc.construct(_data, _length, s);
 		_alloc.construct(end(), '\0');
 	}
 
 	template<typename CharType, typename Allocator >
-	tbasic_string<CharType, Allocator>::tbasic_string(const_iterator s) :
-		_alloc(), _length(Tstrlen<CharType>(s)), _capability(Tstrlen<CharType>(s) << 1), _data(_alloc.allocate(_capability + 1))
+	tbasic_string<CharType, Allocator>::tbasic_string(const_iterator s, const Allocator& alloc) :
+		_alloc(alloc), _length(Tstrlen<CharType>(s)), _capability(Tstrlen<CharType>(s) << 1), _data(_alloc.allocate(_capability + 1))
 	{
 		uninitialized_copy(s, s + Tstrlen<CharType>(s) + 1, _data);
 	}
 
 	template<typename CharType, typename Allocator >
-	tbasic_string<CharType, Allocator>::tbasic_string(const_iterator first, const_iterator last) :
-		_alloc(), _length(last - first), _capability((last - first) << 1), _data(_alloc.allocate(_capability + 1))
+	tbasic_string<CharType, Allocator>::tbasic_string(const_iterator first, const_iterator last, const Allocator& alloc) :
+		_alloc(alloc), _length(last - first), _capability((last - first) << 1), _data(_alloc.allocate(_capability + 1))
 	{
 		uninitialized_copy(first, last, _data);
 		_alloc.construct(end(), '\0');
 	}
 
 	template<typename CharType, typename Allocator >
-	tbasic_string<CharType, Allocator>::tbasic_string(initializer_list<value_type> ilist) :
-		_alloc(), _length(ilist.size()), _capability(ilist.size() << 1), _data(_alloc.allocate(_capability + 1))
+	tbasic_string<CharType, Allocator>::tbasic_string(initializer_list<value_type> ilist, const Allocator& alloc) :
+		_alloc(alloc), _length(ilist.size()), _capability(ilist.size() << 1), _data(_alloc.allocate(_capability + 1))
 	{
 		uninitialized_copy(ilist.begin(), ilist.end(), _data);
 		_alloc.construct(end(), '\0');
@@ -296,14 +351,14 @@ namespace toy_std
 
 	template<typename CharType, typename Allocator >
 	tbasic_string<CharType, Allocator>::tbasic_string(const tbasic_string<CharType, Allocator>& t) :
-		_alloc(), _capability(t._capability), _length(t._length), _data(_alloc.allocate(_capability + 1))
+		_alloc(_alloc_traits::select_on_container_copy_construction(t._alloc)), _capability(t._capability), _length(t._length), _data(_alloc.allocate(_capability + 1))
 	{
 		uninitialized_copy(t.cbegin(), t.cend() + 1, _data);
 
 	}
 
 	template<typename CharType, typename Allocator >
-	tbasic_string<CharType, Allocator>::tbasic_string(const tbasic_string<CharType, Allocator>&& rt) noexcept :
+	tbasic_string<CharType, Allocator>::tbasic_string(tbasic_string<CharType, Allocator>&& rt) noexcept :
 		_alloc(rt._alloc), _capability(rt._capability), _length(rt._length), _data(rt._data)
 	{
 		rt._data = nullptr;
@@ -324,8 +379,9 @@ namespace toy_std
 		*/
 
 		/* New Version: self-assignment-safe */
-		tbasic_string<CharType, Allocator> _tmp(t);
-		swap(_tmp);
+		using propagate = typename _alloc_traits::propagate_on_container_copy_assignment;
+		tbasic_string<CharType, Allocator> _tmp(t.cbegin(), t.cend(), _assign_alloc(t, propagate()));
+		_swap_all(_tmp);
 		return *this;
 
 	}
@@ -334,7 +390,7 @@ namespace toy_std
 	tbasic_string<CharType, Allocator>&
 		tbasic_string<CharType, Allocator>::operator=(const_iterator s)
 	{
-		tbasic_string<CharType, Allocator> _tmp(s);
+		tbasic_string<CharType, Allocator> _tmp(s, _alloc);
 		swap(_tmp);
 		return *this;
 
@@ -343,10 +399,10 @@ namespace toy_std
 
 	template<typename CharType, typename Allocator >
 	tbasic_string<CharType, Allocator>&
-		tbasic_string<CharType, Allocator>::operator=(const tbasic_string<CharType, Allocator>&& rt) noexcept
+		tbasic_string<CharType, Allocator>::operator=(tbasic_string<CharType, Allocator>&& rt) noexcept
 	{
-		tbasic_string<CharType, Allocator> _tmp(rt);
-		swap(_tmp);
+		if (this != &rt)
+			_move_assign(rt, typename _alloc_traits::propagate_on_container_move_assignment());
 		return *this;
 	}
 
@@ -538,7 +594,7 @@ namespace toy_std
 			if (pos + n > _length)
 				throw range_error("RANGE_ERROR: pos + n must be small than length() or equal it.");
 
-			return tbasic_string<CharType, Allocator>(_data + pos, _data + pos + n);
+			return tbasic_string<CharType, Allocator>(_data + pos, _data + pos + n, _alloc);
 
 		}
 		catch (range_error err)
@@ -579,7 +635,8 @@ namespace toy_std
 		tbasic_string<CharType, Allocator>::swap(tbasic_string<CharType, Allocator>& str)
 	{
 		// pimpl: Pointer to Implementation
-		std::swap(_alloc, str._alloc);
+		// Without propagate_on_container_swap the allocators must be equal.
+		_swap_alloc(str, typename _alloc_traits::propagate_on_container_swap());
 		std::swap(_data, str._data);    // !
 		std::swap(_length, str._length);
 		std::swap(_capability, str._capability);
@@ -709,7 +766,7 @@ namespace toy_std
 		}
 		_CHs[i] = (CharType)0;
 
-		tbasic_string<CharType, Allocator> _tmp(_CHs);
+		tbasic_string<CharType, Allocator> _tmp(_CHs, s._alloc);
 		s.swap(_tmp);
 
 		delete[] _CH;
@@ -721,7 +778,7 @@ namespace toy_std
 	tbasic_string<CharType, Allocator>
 		operator+(const tbasic_string<CharType, Allocator>& a, tbasic_string<CharType, Allocator>& b)
 	{
-		tbasic_string<CharType, Allocator> _res(a._data);
+		tbasic_string<CharType, Allocator> _res(a._data, a._alloc);
 		_res.append(b._data);
 		return _res;
 	}
@@ -0,0 +1,625 @@
+/*
+    Project:        toyalloc_test
+    Update date:    2026/10/17
+    Author:         Zhuofan Zhang
+*/
+#define __TOY_ALLOC_STATS
+#include"toymemory.hpp"
+#include"toylist.hpp"
+#include<cstring>
+#include<sstream>
+#include<string>
+#include<thread>
+#include<vector>
+using toy_std::__default_alloc;
+using toy_std::__lockfree_alloc;
+using toy_std::__thread_alloc;
+using toy_std::__lockfree_thread_alloc;
+using std::cout;
+using std::endl;
+
+const int THREADS = 16;
+const int ROUNDS = 200000;
+const int LIVE = 64;
+
+/*
+    Every thread keeps 'LIVE' blocks of mixed sizes alive, stamps them
+    with its id and checks the stamp right before giving them back:
+    a block handed to two threads at once shows up as a bad stamp.
+*/
+template<typename Alloc>
+int StressWorker(int id)
+{
+    struct Slot { unsigned char* p; size_t n; };
+    Slot live[LIVE] = { };
+    int errors = 0;
+    unsigned seed = 2166136261u ^ (unsigned)id;
+
+    for (int r = 0; r < ROUNDS; ++r)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        Slot& s = live[(seed >> 8) % LIVE];
+        if (s.p != nullptr)
+        {
+            for (size_t i = 0; i < s.n; ++i)
+                if (s.p[i] != (unsigned char)id)
+                {
+                    ++errors;
+                    break;
+                }
+            Alloc::deallocate(s.p, s.n);
+        }
+        s.n = 1 + (seed >> 16) % 1024;     // linear and geometric classes
+        s.p = (unsigned char*)Alloc::allocate(s.n);
+        for (size_t i = 0; i < s.n; ++i)
+            s.p[i] = (unsigned char)id;
+    }
+
+    for (int i = 0; i < LIVE; ++i)
+        if (live[i].p != nullptr)
+            Alloc::deallocate(live[i].p, live[i].n);
+    return errors;
+}
+
+template<typename Alloc>
+bool StressCheck(const char* name)
+{
+    std::vector<std::thread> workers;
+    std::vector<int> errors(THREADS, 0);
+    for (int t = 0; t < THREADS; ++t)
+        workers.emplace_back([t, &errors]() { errors[t] = StressWorker<Alloc>(t + 1); });
+    for (auto& w : workers)
+        w.join();
+
+    int total = 0;
+    for (int e : errors)
+        total += e;
+    cout << name << ": " << THREADS << " threads x " << ROUNDS
+         << " rounds, corrupted blocks: " << total << endl;
+    return total == 0;
+}
+
+/*
+    Chunk source whose chunks are 16 bytes past a 64-byte boundary: only
+    max_align_t aligned, as malloc may return them. Counts live chunks.
+*/
+int LiveChunks = 0;
+
+struct OffsetChunkSource
+{
+    static const size_t alignment = 16;
+
+    static void* allocate(size_t& bytes)
+    {
+        char* p = (char*)aligned_alloc(64, (bytes + 16 + 63) & ~size_t(63));
+        if (p == nullptr)
+            return nullptr;
+        ++LiveChunks;
+        return p + 16;
+    }
+    static void* oom_allocate(size_t& bytes)
+    {
+        void* p = allocate(bytes);
+        if (p == nullptr)
+            throw std::bad_alloc();
+        return p;
+    }
+    static void deallocate(void* p, size_t)
+    {
+        --LiveChunks;
+        free((char*)p - 16);
+    }
+};
+
+// A pool with 32-byte classes over that source: once every block is back, trim() frees every chunk.
+bool OverAlignedTrimCheck()
+{
+    using pool = toy_std::__default_alloc_template<90, toy_std::__size_classes<32, 1024>, OffsetChunkSource>;
+    std::vector<void*> blocks;
+    for (int i = 0; i < 2000; ++i)
+        blocks.push_back(pool::allocate(32 + (i % 4) * 96));
+    int peak = LiveChunks;
+    for (int i = 0; i < 2000; ++i)
+        pool::deallocate(blocks[i], 32 + (i % 4) * 96);
+    size_t released = pool::trim();
+    cout << "Over-aligned pool: " << peak << " chunks, " << released
+         << " bytes trimmed, chunks left: " << LiveChunks << endl;
+    return LiveChunks == 0;
+}
+
+/*
+    trim(): a chunk with a live block stays, fully free ones go back; with
+    a threshold set, frees trim on their own. The lock-free pool never trims.
+*/
+bool TrimCheck()
+{
+    using pool = toy_std::__default_alloc_template<91, toy_std::__default_size_classes, OffsetChunkSource>;
+    std::vector<void*> blocks;
+    for (int i = 0; i < 3000; ++i)
+        blocks.push_back(pool::allocate(8 + (i % 64) * 24));
+    int peak = LiveChunks;
+    for (int i = 1; i < 3000; ++i)
+        pool::deallocate(blocks[i], 8 + (i % 64) * 24);
+    pool::trim();
+    bool ok = peak > 1 && LiveChunks == 1;
+    pool::deallocate(blocks[0], 8);
+    ok &= pool::trim() > 0 && LiveChunks == 0 && pool::trim() == 0;
+
+    pool::set_trim_threshold(64 * 1024);
+    for (int i = 0; i < 3000; ++i)
+        blocks[i] = pool::allocate(8 + (i % 64) * 24);
+    for (int i = 0; i < 3000; ++i)
+        pool::deallocate(blocks[i], 8 + (i % 64) * 24);
+    int left = LiveChunks;
+    ok &= left < peak;
+    pool::set_trim_threshold(0);
+    pool::trim();
+
+    ok &= __lockfree_alloc::trim() == 0;
+    cout << "Trim: " << peak << " chunks, 1 kept for a live block, " << left
+         << " left after threshold trims: " << (ok ? "ok" : "FAILED") << endl;
+    return ok;
+}
+
+// Class layout: the SGI table below 128 bytes, four classes per power of two above.
+bool SizeClassCheck()
+{
+    using sgi = toy_std::__size_classes<8, 128>;
+    using classes = toy_std::__default_size_classes;
+    bool ok = sgi::nlists == 16 && sgi::round_up(1) == 8 && sgi::round_up(100) == 104
+              && sgi::index(128) == 15 && sgi::size_of(15) == 128;
+
+    const size_t sizes[] = { 136, 160, 161, 200, 256, 257, 1000, 4096 };
+    const size_t rounded[] = { 160, 160, 192, 224, 256, 320, 1024, 4096 };
+    for (int i = 0; i < 8; ++i)
+        ok &= classes::round_up(sizes[i]) == rounded[i];
+    ok &= classes::nlists == 36 && classes::size_of(classes::nlists - 1) == 4096;
+    for (size_t i = 0; i < classes::nlists; ++i)
+        ok &= classes::index(classes::size_of(i)) == i
+              && classes::size_of(i) % classes::align_of(i) == 0;
+
+    ok &= classes::align_of(classes::index(96)) == 32 && classes::align_of(classes::index(192)) == 64;
+    ok &= classes::aligned_size(40, 64) == 64 && classes::aligned_size(100, 64) == 128
+          && classes::aligned_size(8, 32) == 32;
+    ok &= classes::aligned_size(5000, 8) == 0 && classes::aligned_size(8, 128) == 0;
+    ok &= classes::floor_index(200) == classes::index(192) && classes::floor_index(8192) == classes::nlists - 1;
+    cout << "Size classes: " << classes::nlists << " lists, layout " << (ok ? "ok" : "FAILED") << endl;
+    return ok;
+}
+
+/*
+    Reclaim callbacks of a private __malloc_alloc_template instance run
+    lowest priority first, ties in registration order; the retry follows
+    every callback that released something.
+*/
+std::string ReclaimOrder;
+size_t Released = 1;
+
+size_t ReclaimA() { ReclaimOrder += 'A'; return Released; }
+size_t ReclaimB() { ReclaimOrder += 'B'; return Released; }
+size_t ReclaimC() { ReclaimOrder += 'C'; return Released; }
+size_t ReclaimD() { ReclaimOrder += 'D'; return Released; }
+
+bool ReclaimOrderCheck()
+{
+    using malloc_alloc = toy_std::__malloc_alloc_template<7>;
+    static char token;
+    bool ok = malloc_alloc::register_reclaim(&ReclaimA, 10)
+              && malloc_alloc::register_reclaim(&ReclaimB, 5)
+              && malloc_alloc::register_reclaim(&ReclaimC, 10)
+              && malloc_alloc::register_reclaim(&ReclaimD, 5);
+    ok &= !malloc_alloc::register_reclaim(&ReclaimA, 1);       // already there
+
+    int tries = 0;
+    auto never = [&tries]() -> void* { ++tries; return nullptr; };
+    ok &= malloc_alloc::reclaim_and_retry(never) == nullptr;
+    ok &= ReclaimOrder == "BDACBDACBDAC" && tries == 12;       // 3 rounds by default
+
+    ReclaimOrder.clear();
+    tries = 0;
+    auto second = [&tries]() -> void* { return ++tries == 2 ? &token : nullptr; };
+    ok &= malloc_alloc::reclaim_and_retry(second) == &token && ReclaimOrder == "BD";
+
+    ReclaimOrder.clear();
+    Released = 0;                                               // a dry round ends it
+    ok &= malloc_alloc::reclaim_and_retry(never) == nullptr && ReclaimOrder == "BDAC";
+    Released = 1;
+
+    ReclaimOrder.clear();
+    malloc_alloc::set_reclaim_rounds(1);
+    ok &= malloc_alloc::unregister_reclaim(&ReclaimD) && !malloc_alloc::unregister_reclaim(&ReclaimD);
+    malloc_alloc::reclaim_and_retry(never);
+    ok &= ReclaimOrder == "BAC";
+
+    malloc_alloc::unregister_reclaim(&ReclaimA);
+    malloc_alloc::unregister_reclaim(&ReclaimB);
+    malloc_alloc::unregister_reclaim(&ReclaimC);
+    cout << "Reclaim callbacks: priority order, ties in registration order: "
+         << (ok ? "ok" : "FAILED") << endl;
+    return ok;
+}
+
+/*
+    __debug_alloc_template: every misuse reaches the report handler with
+    the offending pointer and the block is kept out of the pool. The test
+    then frees the block properly(or fixes the redzone) so nothing leaks.
+*/
+std::string LastReport;
+const void* LastReported = nullptr;
+
+void RecordReport(const char* what, const void* p)
+{
+    LastReport = what;
+    LastReported = p;
+}
+
+bool Reported(const char* what, const void* p)
+{
+    bool hit = LastReport.find(what) != std::string::npos && LastReported == p;
+    LastReport.clear();
+    LastReported = nullptr;
+    return hit;
+}
+
+bool DebugAllocCheck()
+{
+    using dbg = toy_std::__debug_alloc_template<__default_alloc>;
+    auto old = dbg::set_report_handler(&RecordReport);
+    bool ok = true;
+
+    char* p = (char*)dbg::allocate(24);
+    dbg::deallocate(p, 24);
+    ok &= LastReported == nullptr;
+    dbg::deallocate(p, 24);
+    ok &= Reported("double free", p);
+
+    p = (char*)dbg::allocate(40);
+    dbg::deallocate(p, 32);
+    ok &= Reported("wrong-size free: allocated 40 bytes, freed as 32", p);
+    dbg::deallocate(p, 40);
+    ok &= LastReported == nullptr;
+
+    p = (char*)dbg::allocate(16);
+    char saved = p[16];
+    p[16] = 'x';                                // one byte past the end
+    dbg::deallocate(p, 16);
+    ok &= Reported("redzone overwritten", p);
+    p[16] = saved;
+    dbg::deallocate(p, 16);
+    ok &= LastReported == nullptr;
+
+    p = (char*)dbg::allocate(8);
+    dbg::deallocate(p, 8);
+    p[0] = 1;                                   // caught when it leaves the quarantine
+    for (int i = 0; i < __TOY_ALLOC_DEBUG_QUARANTINE; ++i)
+        dbg::deallocate(dbg::allocate(8), 8);
+    ok &= Reported("use after free", p);
+
+    dbg::set_report_handler(old);
+    cout << "__debug_alloc: double free, wrong-size free, overflow, use after free reported: "
+         << (ok ? "ok" : "FAILED") << endl;
+    return ok;
+}
+
+// Over-aligned requests: pool classes up to a cache line, aligned_alloc past it.
+struct alignas(32) Vec8f { float v[8]; };
+struct alignas(64) CacheLine { char bytes[64]; };
+
+template<typename Alloc>
+bool AlignedPoolCheck(const char* name)
+{
+    const size_t aligns[] = { 16, 32, 64, 128 };
+    bool ok = true;
+    for (size_t align : aligns)
+        for (size_t n = 1; n <= 600; n += 37)
+        {
+            void* p = Alloc::allocate_aligned(n, align);
+            ok &= (uintptr_t)p % align == 0;
+            memset(p, 0xAB, n);
+            Alloc::deallocate_aligned(p, n, align);
+        }
+    cout << name << "::allocate_aligned(16..128): " << (ok ? "ok" : "FAILED") << endl;
+    return ok;
+}
+
+template<typename T>
+bool AlignedTallocatorCheck(const char* name)
+{
+    toy_std::tallocator<T> a;
+    bool ok = true;
+    T* single[16];
+    for (size_t n = 1; n <= 16; ++n)
+    {
+        single[n - 1] = a.allocate(n);
+        ok &= (uintptr_t)single[n - 1] % alignof(T) == 0;
+    }
+    for (size_t n = 1; n <= 16; ++n)
+        a.deallocate(single[n - 1], n);
+
+    T* batch[8];
+    a.allocate_batch(3, 8, batch);
+    for (T* p : batch)
+        ok &= (uintptr_t)p % alignof(T) == 0;
+    a.deallocate_batch(3, 8, batch);
+    cout << "tallocator<" << name << ">: " << (ok ? "ok" : "FAILED") << endl;
+    return ok;
+}
+
+/*
+    __numa_alloc: the calling thread maps to one of the compiled-in node
+    pools, the node table routes node k to instance k, a node pool
+    works(and trims) even when the host has fewer nodes than that, and
+    a free goes back to the node the block came from.
+*/
+bool NumaCheck()
+{
+    using numa = toy_std::__numa_alloc;
+    using table = toy_std::__numa_node_table_of<__TOY_NUMA_MAX_NODES>::type;
+    int pools = toy_std::__numa_node_count() < __TOY_NUMA_MAX_NODES
+                ? toy_std::__numa_node_count() : __TOY_NUMA_MAX_NODES;
+    int node = numa::node();
+    bool ok = node >= 0 && node < pools && numa::node() == node;
+    numa::rebind_thread();
+    ok &= numa::node() >= 0 && numa::node() < pools;
+
+    ok &= table::get(0)->allocate == &toy_std::__numa_node_thread_alloc<0>::allocate
+          && (__TOY_NUMA_MAX_NODES < 2
+              || table::get(1)->allocate == &toy_std::__numa_node_thread_alloc<1>::allocate)
+          && table::get(__TOY_NUMA_MAX_NODES - 1)->trim
+             == &toy_std::__numa_node_thread_alloc<__TOY_NUMA_MAX_NODES - 1>::trim;
+
+    // Node 1's pool, whether or not this host has a node 1.
+    using node1 = toy_std::__numa_node_alloc<1>;
+    std::vector<char*> blocks;
+    for (int i = 0; i < 2000; ++i)
+    {
+        blocks.push_back((char*)node1::allocate(8 + (i % 16) * 8));
+        memset(blocks.back(), 0x5A, 8 + (i % 16) * 8);
+    }
+    for (int i = 0; i < 2000; ++i)
+        node1::deallocate(blocks[i], 8 + (i % 16) * 8);
+    ok &= node1::trim() > 0;
+
+    // Blocks allocated on this thread's node and freed by another thread.
+    for (int i = 0; i < 2000; ++i)
+        blocks[i] = (char*)numa::allocate(64);
+    void* wide = numa::allocate_aligned(200, 64);
+    ok &= (uintptr_t)wide % 64 == 0;
+    std::thread([&blocks, wide]()
+    {
+        for (char* p : blocks)
+            numa::deallocate(p, 64);
+        numa::deallocate_aligned(wide, 200, 64);
+    }).join();
+    numa::trim();
+
+    // Node 1's blocks freed by a node-0 thread land back in node 1's pool.
+    using node1_cached = toy_std::__numa_node_thread_alloc<1>;
+    void* local = numa::allocate(32);
+    void* big = numa::allocate(5000);
+    ok &= numa::node_of(local) == numa::node() && numa::node_of(big) == -1;
+    numa::deallocate(local, 32);
+    numa::deallocate(big, 5000);
+    for (int i = 0; i < 2000; ++i)
+        blocks[i] = (char*)node1_cached::allocate(48);
+    ok &= numa::node_of(blocks[0]) == 1 && numa::node_of(blocks[1999]) == 1;
+    for (int i = 0; i < 2000; ++i)
+        numa::deallocate(blocks[i], 48);
+    node1_cached::trim();
+    ok &= node1::stats().heap_bytes == 0;
+
+    cout << "__numa_alloc: " << toy_std::__numa_node_count() << " node(s), thread on node "
+         << node << ", node pools " << (ok ? "ok" : "FAILED") << endl;
+    return ok;
+}
+
+/*
+    tmonotonic_arena: bumps through a block, honours the requested
+    alignment, serves a user buffer first and rewinds on reset();
+    a tlist over tarena_allocator takes its nodes from the arena.
+*/
+bool ArenaCheck()
+{
+    bool ok = true;
+    {
+        toy_std::tmonotonic_arena arena(1024);
+        char* a = (char*)arena.allocate(24, 8);
+        char* b = (char*)arena.allocate(8, 8);
+        ok &= b == a + 24;
+        void* wide = arena.allocate(40, 64);
+        ok &= (uintptr_t)wide % 64 == 0;
+        for (int i = 0; i < 100; ++i)              // several blocks deep
+            arena.allocate(100, 16);
+        char* last = (char*)arena.allocate(16, 16);
+        arena.reset();                              // keeps the newest block only
+        char* again = (char*)arena.allocate(16, 16);
+        ok &= again <= last && last - again < 16384;
+        arena.release();
+    }
+    {
+        alignas(16) char buffer[256];
+        toy_std::tmonotonic_arena arena(buffer, sizeof(buffer));
+        char* first = (char*)arena.allocate(64);
+        ok &= first == buffer;
+        char* heap = (char*)arena.allocate(512);
+        ok &= heap < buffer || heap >= buffer + sizeof(buffer);
+        arena.reset();
+        ok &= arena.allocate(64) == buffer;
+    }
+    {
+        toy_std::tmonotonic_arena arena;
+        using arena_list = toy_std::tlist<int, toy_std::tarena_allocator<toy_std::__tList_Node<int>>>;
+        toy_std::tarena_allocator<toy_std::__tList_Node<int>> alloc(arena);
+        arena_list l(alloc);
+        for (int i = 0; i < 100; ++i)
+            l.push_back(i);
+        int sum = 0;
+        for (int x : l)
+            sum += x;
+        ok &= l.size() == 100 && sum == 4950 && l.get_allocator() == alloc;
+    }
+    cout << "tmonotonic_arena: bump/align/buffer/reset, tlist on the arena: "
+         << (ok ? "ok" : "FAILED") << endl;
+    return ok;
+}
+
+/*
+    Pools over mmap'd chunks: blocks are writable and, once all are back,
+    trim() unmaps every chunk. Chunks come in whole granules, so each one
+    holds nearly a granule at least. 64 KiB granules keep the second pool
+    small; the first one is the stock huge-page pool.
+*/
+template<typename Pool>
+bool MmapPoolCheck(const char* name, size_t granule)
+{
+    std::vector<char*> blocks;
+    for (int i = 0; i < 4000; ++i)
+    {
+        char* p = (char*)Pool::allocate(16 + (i % 32) * 64);
+        memset(p, i & 0xFF, 16 + (i % 32) * 64);
+        blocks.push_back(p);
+    }
+    typename Pool::stats_type st = Pool::stats();
+    bool ok = st.chunk_mallocs > 0 && st.heap_bytes >= st.chunk_mallocs * (granule - 256);
+    for (int i = 0; i < 4000; ++i)
+    {
+        ok &= blocks[i][0] == (char)(i & 0xFF);
+        Pool::deallocate(blocks[i], 16 + (i % 32) * 64);
+    }
+    ok &= Pool::trim() > 0 && Pool::stats().heap_bytes == 0;
+    cout << name << ": " << st.chunk_mallocs << " chunks mapped, all unmapped by trim: "
+         << (ok ? "ok" : "FAILED") << endl;
+    return ok;
+}
+
+// Counters of one refill: 20 blocks carved, the first handed out, the next 9 are hits.
+bool StatsCheck()
+{
+    using pool = toy_std::__default_alloc_template<92>;
+    const size_t idx = pool::size_class::index(24);
+    void* blocks[10];
+    for (int i = 0; i < 10; ++i)
+        blocks[i] = pool::allocate(24);
+    void* big = pool::allocate(5000);
+
+    pool::stats_type st = pool::stats();
+    bool ok = st.classes[idx].block_size == 24 && st.classes[idx].allocs == 10
+              && st.classes[idx].hits == 9 && st.classes[idx].refills == 1
+              && st.chunk_allocs == 1 && st.chunk_mallocs == 1 && st.heap_bytes > 0
+              && st.malloc_fallbacks == 1;
+
+    for (int i = 0; i < 10; ++i)
+        pool::deallocate(blocks[i], 24);
+    pool::deallocate(big, 5000);
+    st = pool::stats();
+    ok &= st.classes[idx].frees == 10 && st.idle_bytes == 20 * 24;
+
+    size_t released = pool::trim();
+    st = pool::stats();
+    ok &= st.trims == 1 && st.trimmed_bytes == released && st.heap_bytes == 0;
+
+    std::ostringstream dump;
+    pool::dump_stats(dump);
+    ok &= dump.str().find("pool<92>") != std::string::npos;
+    cout << "Stats: " << st.classes[idx].allocs << " allocs/" << st.classes[idx].frees
+         << " frees of 24 B, " << released << " B trimmed: " << (ok ? "ok" : "FAILED") << endl;
+    return ok;
+}
+
+/*
+    tobject_pool: a freed slot is the next one handed out, slabs come and
+    go with their objects(one spare kept), and a pool torn down with live
+    objects in full slabs gives every slab back(run under a leak checker).
+*/
+bool ObjectPoolCheck()
+{
+    struct Node { void* links[2]; long value; };
+    using pool_type = toy_std::tobject_pool<Node>;
+    const size_t per_slab = pool_type::objects_per_slab();
+    bool ok = true;
+    {
+        pool_type pool;
+        Node* a = pool.allocate();
+        Node* b = pool.allocate();
+        pool.deallocate(a);
+        ok &= pool.allocate() == a;             // LIFO slot reuse
+        pool.deallocate(a);
+        pool.deallocate(b);
+
+        std::vector<Node*> nodes;
+        for (size_t i = 0; i < 3 * per_slab; ++i)
+            nodes.push_back(pool.allocate());
+        ok &= pool.slabs() == 3 && pool.live() == 3 * per_slab;
+        for (Node* p : nodes)
+            pool.deallocate(p);
+        ok &= pool.live() == 0 && pool.slabs() == 1;    // the spare
+
+        // Leave two full slabs and a partial one live at teardown.
+        for (size_t i = 0; i < 2 * per_slab + 1; ++i)
+            pool.allocate();
+        ok &= pool.slabs() == 3;
+    }
+    cout << "tobject_pool: " << per_slab << " objects per slab, reuse/teardown "
+         << (ok ? "ok" : "FAILED") << endl;
+    return ok;
+}
+
+int main()
+{
+    cout << "**** Allocator Stress Check ****" << endl;
+    bool ok = true;
+    ok &= StressCheck<__default_alloc>("__default_alloc");
+    ok &= StressCheck<__lockfree_alloc>("__lockfree_alloc");
+    ok &= StressCheck<__thread_alloc>("__thread_alloc");
+    ok &= StressCheck<__lockfree_thread_alloc>("__lockfree_thread_alloc");
+    ok &= StressCheck<toy_std::__numa_alloc>("__numa_alloc");
+    cout << "********************************" << endl;
+
+    cout << "**** Size Class Check ****" << endl;
+    ok &= SizeClassCheck();
+    cout << "**************************" << endl;
+
+    cout << "**** Stats Check ****" << endl;
+    ok &= StatsCheck();
+    cout << "*********************" << endl;
+
+    cout << "**** Reclaim Check ****" << endl;
+    ok &= ReclaimOrderCheck();
+    cout << "***********************" << endl;
+
+    cout << "**** Debug Alloc Check ****" << endl;
+    ok &= DebugAllocCheck();
+    cout << "***************************" << endl;
+
+    cout << "**** Alignment Check ****" << endl;
+    ok &= AlignedPoolCheck<__default_alloc>("__default_alloc");
+    ok &= AlignedPoolCheck<__lockfree_alloc>("__lockfree_alloc");
+    ok &= AlignedPoolCheck<__thread_alloc>("__thread_alloc");
+    ok &= AlignedTallocatorCheck<Vec8f>("alignas(32)");
+    ok &= AlignedTallocatorCheck<CacheLine>("alignas(64)");
+    cout << "*************************" << endl;
+
+    cout << "**** NUMA Check ****" << endl;
+    ok &= NumaCheck();
+    cout << "********************" << endl;
+
+    cout << "**** Arena Check ****" << endl;
+    ok &= ArenaCheck();
+    cout << "*********************" << endl;
+
+    cout << "**** Mmap Chunk Check ****" << endl;
+    ok &= MmapPoolCheck<toy_std::__hugepage_alloc>("__hugepage_alloc", size_t(2) << 20);
+    ok &= MmapPoolCheck<toy_std::__default_alloc_template<93, toy_std::__default_size_classes,
+                        toy_std::__mmap_chunk_source<false, 65536>>>("64 KiB mmap pool", 65536);
+    cout << "**************************" << endl;
+
+    cout << "**** Trim Check ****" << endl;
+    ok &= TrimCheck();
+    ok &= OverAlignedTrimCheck();
+    cout << "********************" << endl;
+
+    cout << "**** Object Pool Check ****" << endl;
+    ok &= ObjectPoolCheck();
+    cout << "***************************" << endl;
+    return ok ? 0 : 1;
+}
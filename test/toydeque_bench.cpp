@@ -0,0 +1,99 @@
+/*
+    Project:        toydeque_bench
+    Update date:    2026/10/17
+    Author:         Zhuofan Zhang
+
+    FIFO traffic(push_back/pop_front at a steady length) through tdeque:
+    buffer allocations per million operations with the spare-buffer cache
+    off(depth 0) and on(default depth), and the time against std::deque.
+*/
+#include"toydeque.hpp"
+#include<deque>
+#include<chrono>
+using toy_std::tdeque;
+using std::cout;
+using std::endl;
+
+const int OPS = 1000000;
+const int LENGTH = 1000;        // elements kept in flight
+
+struct Timer
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    double ms() const
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+};
+
+// tallocator that counts the calls reaching it.
+size_t Allocations = 0;
+
+template<typename T>
+struct CountingAllocator : toy_std::tallocator<T>
+{
+    template<typename U>
+    struct rebind { using other = CountingAllocator<U>; };
+
+    CountingAllocator() = default;
+    template<typename U>
+    CountingAllocator(const CountingAllocator<U>&) { }
+
+    T* allocate(size_t n)
+    {
+        ++Allocations;
+        return toy_std::tallocator<T>::allocate(n);
+    }
+};
+
+template<typename T, typename U>
+bool operator==(const CountingAllocator<T>&, const CountingAllocator<U>&) { return true; }
+
+template<typename Deque>
+void Fifo(Deque& q)
+{
+    for (int i = 0; i < LENGTH; ++i)
+        q.push_back(i);
+    for (int i = 0; i < OPS; ++i)
+    {
+        q.push_back(i);
+        q.pop_front();
+    }
+}
+
+void Allocs(size_t depth)
+{
+    tdeque<int, 0, CountingAllocator<int>> q;
+    q.set_buffer_cache_depth(depth);
+    for (int i = 0; i < LENGTH; ++i)
+        q.push_back(i);
+    Allocations = 0;
+    Timer t;
+    for (int i = 0; i < OPS; ++i)
+    {
+        q.push_back(i);
+        q.pop_front();
+    }
+    double ms = t.ms();
+    cout << "  cache depth " << depth << ": " << Allocations << " allocations / "
+         << OPS / 1000000 << "M ops, " << ms << " ms" << endl;
+}
+
+int main()
+{
+    cout << "**** tdeque FIFO Benchmark ****" << endl;
+    Allocs(0);
+    Allocs(toy_std::__DEQUE_CACHE_DEPTH);
+
+    tdeque<int> tq;
+    std::deque<int> sq;
+    Timer tt;
+    Fifo(tq);
+    double tms = tt.ms();
+    Timer st;
+    Fifo(sq);
+    double sms = st.ms();
+    cout << "  tdeque " << tms << " ms, std::deque " << sms << " ms" << endl;
+    cout << "*******************************" << endl;
+    return 0;
+}
@@ -0,0 +1,202 @@
+/*
+    Project:        toydeque_test
+    Update date:    2026/10/17
+    Author:         Zhuofan Zhang
+*/
+#include"toydeque.hpp"
+#include<string>
+using toy_std::tdeque;
+using std::cout;
+using std::endl;
+
+template<typename Deque>
+void Print(const char* name, const Deque& d)
+{
+    cout << name;
+    for (auto it = d.begin(); it != d.end(); ++it)
+        cout << *it << ' ';
+    cout << endl;
+}
+
+// The copy throws once 'Countdown' reaches zero; counts live objects.
+int Live = 0;
+int Countdown = -1;
+
+struct Bomb
+{
+    int v;
+    Bomb(int x) : v(x) { ++Live; }
+    Bomb(const Bomb& o) : v(o.v)
+    {
+        if (Countdown >= 0 && Countdown-- == 0)
+            throw 1;
+        ++Live;
+    }
+    Bomb(Bomb&& o) noexcept : v(o.v) { ++Live; }
+    Bomb& operator=(const Bomb& o) { v = o.v; return *this; }
+    Bomb& operator=(Bomb&& o) noexcept { v = o.v; return *this; }
+    ~Bomb() { --Live; }
+};
+
+void ConstructorTest()
+{
+    tdeque<int> Default;
+    tdeque<float> InitList({ 1,2,3,4,5 });
+    tdeque<int> SameValue(5, 1);
+    tdeque<float> Copy(InitList);
+    tdeque<float> FromOther(InitList.begin(), InitList.end());
+    tdeque<float> Move(std::move(Copy));
+
+    cout << "**** Constructors Check ****" << endl;
+    cout << "Default Size: " << Default.size() << endl;
+    Print("InitList: ", InitList);
+    Print("SameValue: ", SameValue);
+    Print("FromOther: ", FromOther);
+    Print("Move: ", Move);
+    cout << "Moved-from Size(should be 0): " << Copy.size() << endl;
+    cout << "****************************" << endl;
+}
+
+void ElementAccess()
+{
+    cout << "**** ElementAccess Check ****" << endl;
+    tdeque<int> TestDeque = { 1,2,3,4,5,6 };
+    cout << "front: " << TestDeque.front() << endl;
+    cout << "back: " << TestDeque.back() << endl;
+    cout << "[3]: " << TestDeque[3] << endl;
+    try
+    {
+        TestDeque.at(6);
+    }
+    catch (const std::range_error&)
+    {
+        cout << "at(6): range_error" << endl;
+    }
+    cout << "*****************************" << endl;
+}
+
+void Iterators()
+{
+    cout << "**** Iterators Check ****" << endl;
+    // 4 elements per buffer: iterators cross buffer boundaries.
+    tdeque<char, 4> TestDeque = { 'H','e','l','l','o',',','w','o','r','l','d' };
+    Print("TestDeque: ", TestDeque);
+    cout << "Reverse TestDeque: ";
+    for (auto rit = TestDeque.rbegin(); rit != TestDeque.rend(); ++rit)
+        cout << *rit << ' ';
+    cout << endl;
+    cout << "end() - begin(): " << (TestDeque.end() - TestDeque.begin()) << endl;
+    cout << "begin()[7]: " << TestDeque.begin()[7] << endl;
+    cout << "*************************" << endl;
+}
+
+void Modifiers()
+{
+    cout << "**** Modifers Check ****" << endl;
+    tdeque<int, 4> TestDeque;
+
+    /* push_back/front */
+    for (int i = 0; i < 10; ++i)
+    {
+        TestDeque.push_back(i);
+        TestDeque.push_front(-i - 1);
+    }
+    Print("Push: ", TestDeque);
+
+    /* pop_back/front */
+    for (int i = 0; i < 5; ++i)
+    {
+        TestDeque.pop_back();
+        TestDeque.pop_front();
+    }
+    Print("Pop: ", TestDeque);
+
+    /* insert */
+    auto _oit = TestDeque.insert(TestDeque.begin() + 3, { 100, 101, 102 });
+    Print("Insert: ", TestDeque);
+    cout << "pos check: " << *_oit << endl;
+    TestDeque.insert(TestDeque.end() - 1, 2, 7);
+    Print("Insert 2x7: ", TestDeque);
+
+    /* erase */
+    TestDeque.erase(TestDeque.begin() + 3, TestDeque.begin() + 6);
+    Print("Erase [3,6): ", TestDeque);
+    TestDeque.erase(TestDeque.begin());
+    Print("Erase the first: ", TestDeque);
+
+    /* resize */
+    TestDeque.resize(3);
+    Print("Resize 3: ", TestDeque);
+
+    /* FIFO churn */
+    tdeque<std::string, 4> Queue;
+    for (int i = 0; i < 1000; ++i)
+    {
+        Queue.push_back(std::to_string(i));
+        if (i % 3 != 0)
+            Queue.pop_front();
+    }
+    cout << "FIFO churn size: " << Queue.size() << ", front: " << Queue.front()
+         << ", back: " << Queue.back() << endl;
+
+    /* swap/clear */
+    tdeque<std::string, 4> Other = { "a", "b" };
+    Queue.swap(Other);
+    Print("Swap: ", Queue);
+    Other.clear();
+    cout << "Erase the all(Size shoukd be 0): " << Other.size() << endl;
+
+    cout << "************************" << endl;
+}
+
+/*
+    A copy throwing part-way through an insert, near either end: the
+    deque is left exactly as it was, with nothing leaked.
+*/
+void InsertExceptionSafety()
+{
+    cout << "**** Insert Exception Check ****" << endl;
+    int unchanged = 0, thrown = 0;
+    for (int run = 0; run < 24; ++run)
+    {
+        int op = run / 6, at = run % 6;
+        Live = 0;
+        {
+            tdeque<Bomb, 4> TestDeque;
+            for (int i = 0; i < 10; ++i)
+                TestDeque.emplace_back(i);
+            Bomb Value(9);
+            Bomb Range[] = { 5, 6, 7, 8, 9 };
+            size_t pos = op % 2 == 0 ? 2 : 8;
+            Countdown = at;
+            try
+            {
+                if (op < 2)
+                    TestDeque.insert(TestDeque.begin() + pos, 5, Value);
+                else
+                    TestDeque.insert(TestDeque.begin() + pos, Range, Range + 5);
+            }
+            catch (int)
+            {
+                ++thrown;
+            }
+            Countdown = -1;
+            bool same = TestDeque.size() == 10 && Live == 10 + 6;
+            for (int i = 0; same && i < 10; ++i)
+                same = TestDeque[i].v == i;
+            unchanged += same;
+        }
+        unchanged += Live == 0 ? 0 : -100;
+    }
+    cout << "Throw points(should be 22): " << thrown << ", unchanged(should be 22): " << unchanged << endl;
+    cout << "********************************" << endl;
+}
+
+int main()
+{
+    ConstructorTest();
+    ElementAccess();
+    Iterators();
+    Modifiers();
+    InsertExceptionSafety();
+}
@@ -0,0 +1,90 @@
+/*
+    Project:        toyintrusive_list_test
+    Update date:    2026/10/17
+    Author:         Zhuofan Zhang
+*/
+#include"toyintrusive_list.hpp"
+#include<string>
+using toy_std::tintrusive_list;
+using toy_std::tlist_hook;
+using toy_std::tlist_member_hook;
+using std::cout;
+using std::endl;
+
+struct Entry : public tlist_hook
+{
+    int key;
+    std::string value;
+    Entry(int k, const std::string& v) : key(k), value(v) { }
+};
+
+// One object in two lists at once.
+struct Job
+{
+    int id;
+    tlist_hook queue_hook;
+    tlist_hook owner_hook;
+    explicit Job(int i) : id(i) { }
+};
+
+template<typename List>
+void Print(const char* name, const List& l)
+{
+    cout << name;
+    for (auto it = l.begin(); it != l.end(); ++it)
+        cout << it->key << ' ';
+    cout << endl;
+}
+
+void LruCheck()
+{
+    cout << "**** LRU Check ****" << endl;
+    Entry e[5] = { {1, "a"}, {2, "b"}, {3, "c"}, {4, "d"}, {5, "e"} };
+    tintrusive_list<Entry> lru;
+    for (auto& x : e)
+        lru.push_front(x);
+    Print("Most recent first: ", lru);
+
+    // Touch 2: move it to the front.
+    lru.splice(lru.begin(), lru, lru.iterator_to(e[1]));
+    Print("Touch 2: ", lru);
+
+    // Evict the least recent.
+    cout << "Evict: " << lru.back().key << endl;
+    lru.pop_back();
+    lru.erase(e[3]);
+    Print("After evict 1, erase 4: ", lru);
+    cout << "4 linked: " << e[3].is_linked() << ", size: " << lru.size() << endl;
+    cout << "*******************" << endl;
+}
+
+void MemberHookCheck()
+{
+    cout << "**** Member Hook Check ****" << endl;
+    Job jobs[4] = { Job(10), Job(11), Job(12), Job(13) };
+    tintrusive_list<Job, tlist_member_hook<Job, &Job::queue_hook>> queue;
+    tintrusive_list<Job, tlist_member_hook<Job, &Job::owner_hook>> owned;
+    for (auto& j : jobs)
+    {
+        queue.push_back(j);
+        if (j.id % 2 == 0)
+            owned.push_front(j);
+    }
+    queue.reverse();
+    cout << "Queue(reversed): ";
+    for (auto it = queue.begin(); it != queue.end(); ++it)
+        cout << it->id << ' ';
+    cout << endl << "Owned: ";
+    for (auto it = owned.begin(); it != owned.end(); ++it)
+        cout << it->id << ' ';
+    cout << endl;
+    queue.remove_if([](const Job& j) { return j.id > 11; });
+    cout << "Queue size after remove_if: " << queue.size() << ", owned size: " << owned.size() << endl;
+    cout << "***************************" << endl;
+}
+
+int main()
+{
+    LruCheck();
+    MemberHookCheck();
+}
@@ -0,0 +1,78 @@
+/*
+    Project:        toylist_sort_bench
+    Update date:    2026/10/17
+    Author:         Zhuofan Zhang
+
+    tlist::sort(bottom-up merge, relinking nodes) against std::list::sort
+    on the same random sequence, for int and std::string, ascending with
+    toy_std::less and descending with toy_std::greater.
+*/
+#include"toylist.hpp"
+#include<list>
+#include<string>
+#include<vector>
+#include<random>
+#include<chrono>
+using toy_std::tlist;
+using std::cout;
+using std::endl;
+
+const int N = 100000;
+const int REPEAT = 10;
+
+struct Timer
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    double ms() const
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+};
+
+template<typename T> T MakeValue(unsigned r) { return T(r); }
+template<> std::string MakeValue<std::string>(unsigned r) { return std::to_string(r) + "-payload-payload"; }
+
+template<typename List, typename T, typename Compare>
+double Sort(const std::vector<T>& values, Compare comp, bool& ok)
+{
+    double total = 0;
+    for (int r = 0; r < REPEAT; ++r)
+    {
+        List l(values.begin(), values.end());
+        Timer t;
+        l.sort(comp);
+        total += t.ms();
+
+        auto prev = l.begin(), it = prev;
+        for (++it; it != l.end(); prev = it, ++it)
+            ok = ok && !comp(*it, *prev);
+    }
+    return total / REPEAT;
+}
+
+template<typename T>
+void Compare(const char* name)
+{
+    std::mt19937 gen(2026);
+    std::vector<T> values;
+    for (int i = 0; i < N; ++i)
+        values.push_back(MakeValue<T>(gen()));
+
+    bool ok = true;
+    double tl = Sort<tlist<T>>(values, toy_std::less<T>(), ok);
+    double sl = Sort<std::list<T>>(values, toy_std::less<T>(), ok);
+    double tg = Sort<tlist<T>>(values, toy_std::greater<T>(), ok);
+    double sg = Sort<std::list<T>>(values, toy_std::greater<T>(), ok);
+    cout << name << (ok ? "" : "  (NOT SORTED)") << endl;
+    cout << "  less:     tlist " << tl << " ms, std::list " << sl << " ms" << endl;
+    cout << "  greater:  tlist " << tg << " ms, std::list " << sg << " ms" << endl;
+}
+
+int main()
+{
+    cout << "**** tlist::sort Benchmark(" << N << " elements) ****" << endl;
+    Compare<int>("int");
+    Compare<std::string>("std::string");
+    cout << "*********************************************" << endl;
+    return 0;
+}
@@ -4,12 +4,45 @@
     Author:         Zhuofan Zhang
 */
 #include"toylist.hpp"
+#include<string>
+#include<utility>
 // #include<vector>
 using toy_std::tlist;
 using std::cout;
 using std::endl;
 // using std::vector;
 
+// tallocator that runs out after 'Budget' nodes.
+size_t Budget = 0;
+
+template<typename T>
+struct LimitedAllocator : toy_std::tallocator<T>
+{
+    T* allocate(size_t n)
+    {
+        if (Budget == 0)
+            throw std::bad_alloc();
+        --Budget;
+        return toy_std::tallocator<T>::allocate(n);
+    }
+};
+
+template<typename T>
+bool operator==(const LimitedAllocator<T>&, const LimitedAllocator<T>&) { return true; }
+
+// tallocator whose instances only compare equal to the same 'id'.
+template<typename T>
+struct TaggedAllocator : toy_std::tallocator<T>
+{
+    int id;
+    TaggedAllocator(int i = 0) : id(i) { }
+};
+
+template<typename T>
+bool operator==(const TaggedAllocator<T>& a, const TaggedAllocator<T>& b) { return a.id == b.id; }
+template<typename T>
+bool operator!=(const TaggedAllocator<T>& a, const TaggedAllocator<T>& b) { return a.id != b.id; }
+
 void ConstructorTest()
 {   
     tlist<int> Default;
@@ -109,6 +142,24 @@ void Modifiers()
     cout << endl;
 
 
+    /* emplace: built in place, rvalues moved in */
+    tlist<std::string> Words;
+    std::string heavy(32, 'x');
+    Words.emplace_back(3, 'a');
+    Words.emplace_front("front");
+    Words.emplace(++Words.begin(), "mid");
+    Words.push_back(std::move(heavy));
+    cout << "Emplace: ";
+    for (auto it = Words.begin(); it != Words.end(); ++it)
+        cout << *it << ' ';
+    cout << endl << "Moved-from size: " << heavy.size() << endl;
+    Words.pop_front();
+    Words.pop_back();
+    cout << "Pop both ends (size " << Words.size() << "): ";
+    for (auto it = Words.begin(); it != Words.end(); ++it)
+        cout << *it << ' ';
+    cout << endl;
+
     cout << "************************" << endl;
 }
 
@@ -128,6 +179,11 @@ void Operations()
         cout << *it << ' ';
     cout << endl;
 
+    /* compare */
+    tlist<int> Prefix = { 1,3 };
+    cout << "Compare(should be 1 1 0 1 1 0): " << (Prefix < A) << ' ' << (Prefix <= A) << ' ' << (A < A)
+         << ' ' << (A <= A) << ' ' << (A == A) << ' ' << (A == B) << endl;
+
     /* merge */
     A.merge(std::move(B));
     cout << "Merge (B size: " << B.size() << "): ";
@@ -135,6 +191,25 @@ void Operations()
         cout << *it << ' ';
     cout << endl;
 
+    /* splice */
+    tlist<int> D = { 20, 30 };
+    A.splice(A.begin(), D);
+    cout << "Splice (D size: " << D.size() << "): ";
+    for (auto it = A.begin(); it != A.end(); ++it)
+        cout << *it << ' ';
+    cout << endl;
+    D.splice(D.end(), A, A.begin());
+    D.splice(D.end(), A, A.begin(), A.end());
+    cout << "Splice back (A size: " << A.size() << "): ";
+    for (auto it = D.begin(); it != D.end(); ++it)
+        cout << *it << ' ';
+    cout << endl;
+    A.splice(A.end(), D, ++D.begin(), D.end(), D.size() - 1);
+    cout << "Splice range: ";
+    for (auto it = A.begin(); it != A.end(); ++it)
+        cout << *it << ' ';
+    cout << endl;
+
     /* remove */
     A.remove(5);
     cout << "Remove 5: ";
@@ -161,6 +236,114 @@ void Operations()
 
 }
 
+void SortTest()
+{
+    cout << "**** Sort Check ****" << endl;
+    tlist<int> Empty;
+    Empty.sort();
+    tlist<int> One = { 42 };
+    One.sort();
+    cout << "Empty (size " << Empty.size() << "), one element: " << One.front()
+         << " (size " << One.size() << ')' << endl;
+
+    /* stable: equal keys keep their order */
+    tlist<std::pair<int, char>> Pairs = { {2,'a'}, {1,'b'}, {2,'c'}, {0,'d'}, {1,'e'}, {2,'f'}, {0,'g'} };
+    Pairs.sort([](const std::pair<int, char>& a, const std::pair<int, char>& b) { return a.first < b.first; });
+    cout << "Stable (should be 0d 0g 1b 1e 2a 2c 2f): ";
+    for (auto it = Pairs.begin(); it != Pairs.end(); ++it)
+        cout << (*it).first << (*it).second << ' ';
+    cout << endl;
+
+    /* a long run of ties and a descending input: order and back links */
+    tlist<int> Big;
+    for (int i = 1000; i > 0; --i)
+        Big.push_back(i % 10 == 0 ? 0 : i);
+    Big.sort();
+    bool ascending = true;
+    int prev = -1;
+    for (auto it = Big.begin(); it != Big.end(); ++it)
+    {
+        ascending &= prev <= *it;
+        prev = *it;
+    }
+    size_t backwards = 0;
+    for (auto it = Big.end(); it != Big.begin(); --it)
+        ++backwards;
+    cout << "1000 descending sorted: " << ascending << ", walked back: " << backwards
+         << ", front/back: " << Big.front() << '/' << Big.back() << endl;
+    cout << "********************" << endl;
+}
+
+void MoveTest()
+{
+    cout << "**** Move Check ****" << endl;
+    tlist<std::string> A = { "a", "b", "c" };
+    tlist<std::string> B(std::move(A));
+
+    /* a moved-from list is empty and usable again */
+    cout << "Moved-from size: " << A.size() << ", empty range: " << (A.begin() == A.end()) << endl;
+    tlist<std::string> Empty;
+    cout << "Moved-from compares as empty(should be 1 0 1 1 0): " << (A == Empty) << ' ' << (A < Empty)
+         << ' ' << (A <= Empty) << ' ' << (A < B) << ' ' << (B <= A) << endl;
+    A.push_back("d");
+    A.push_front("e");
+    A.insert(A.end(), 2, "f");
+    cout << "Reused: ";
+    for (auto it = A.begin(); it != A.end(); ++it)
+        cout << *it << ' ';
+    cout << endl;
+
+    /* unequal allocators: the elements move, the nodes stay */
+    using tagged_list = tlist<std::string, TaggedAllocator<toy_std::__tList_Node<std::string>>>;
+    tagged_list C(TaggedAllocator<toy_std::__tList_Node<std::string>>(1));
+    tagged_list D(TaggedAllocator<toy_std::__tList_Node<std::string>>(2));
+    C.push_back(std::string(32, 'x'));
+    C.push_back("y");
+    D.push_back("z");
+    D = std::move(C);
+    cout << "Move-assigned (source size " << C.size() << "): ";
+    for (auto it = D.begin(); it != D.end(); ++it)
+        cout << *it << ' ';
+    cout << endl;
+    cout << "********************" << endl;
+}
+
+void ExceptionSafety()
+{
+    cout << "**** Exception Safety Check ****" << endl;
+    using limited_list = tlist<int, LimitedAllocator<toy_std::__tList_Node<int>>>;
+    Budget = 8;
+    limited_list TestList;
+    TestList.push_back(1);
+    TestList.push_back(2);
+
+    /* allocation fails in a later batch: the list is as it was */
+    Budget = 600;
+    try
+    {
+        TestList.insert(TestList.end(), 1000, 7);
+    }
+    catch (const std::bad_alloc&)
+    {
+        cout << "insert(1000) threw, size: " << TestList.size() << endl;
+    }
+    int arr[1000] = { };
+    Budget = 20;
+    try
+    {
+        TestList.insert(++TestList.begin(), arr, arr + 1000);
+    }
+    catch (const std::bad_alloc&)
+    {
+        cout << "insert(range) threw, size: " << TestList.size() << endl;
+    }
+    cout << "TestList: ";
+    for (auto it = TestList.begin(); it != TestList.end(); ++it)
+        cout << *it << ' ';
+    cout << endl;
+    cout << "********************************" << endl;
+}
+
 int main()
 {
     ConstructorTest();
@@ -168,4 +351,7 @@ int main()
     Iterators();
     Modifiers();
     Operations();
+    SortTest();
+    MoveTest();
+    ExceptionSafety();
 }
\ No newline at end of file
@@ -0,0 +1,124 @@
+/*
+    Project:        toympmc_queue_bench
+    Update date:    2026/10/17
+    Author:         Zhuofan Zhang
+
+    Contention across 1 - 64 threads: half of them push, half pop
+    (1 thread: push then pop). tmpmc_queue against a mutex-guarded
+    std::queue of the same capacity. Every run checks that each value
+    came out exactly once(sum).
+*/
+#include"toympmc_queue.hpp"
+#include<queue>
+#include<mutex>
+#include<thread>
+#include<vector>
+#include<chrono>
+using toy_std::tmpmc_queue;
+using std::cout;
+using std::endl;
+
+const long OPS = 1 << 21;       // elements per run
+const size_t CAPACITY = 1024;
+
+struct Timer
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    double ms() const
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+};
+
+// Bounded std::queue behind one lock; same push/pop interface.
+struct LockedQueue
+{
+    std::mutex lock;
+    std::queue<long> q;
+
+    bool try_push(long v)
+    {
+        std::lock_guard<std::mutex> g(lock);
+        if (q.size() == CAPACITY)
+            return false;
+        q.push(v);
+        return true;
+    }
+    bool try_pop(long& v)
+    {
+        std::lock_guard<std::mutex> g(lock);
+        if (q.empty())
+            return false;
+        v = q.front();
+        q.pop();
+        return true;
+    }
+    void push(long v) { while (!try_push(v)) std::this_thread::yield(); }
+    void pop(long& v) { while (!try_pop(v)) std::this_thread::yield(); }
+};
+
+template<typename Queue>
+double Run(Queue& q, int threads, bool& ok)
+{
+    std::vector<std::thread> workers;
+    std::vector<long> sums(threads, 0);
+    int producers = threads > 1 ? threads / 2 : 1;
+    int consumers = threads > 1 ? threads - producers : 1;
+    Timer t;
+    if (threads == 1)
+    {
+        long v, sum = 0;
+        for (long i = 0; i < OPS; i += CAPACITY)
+        {
+            for (long j = i; j < i + long(CAPACITY); ++j)
+                q.push(j);
+            for (size_t j = 0; j < CAPACITY; ++j, sum += v)
+                q.pop(v);
+        }
+        sums[0] = sum;
+    }
+    else
+    {
+        for (int p = 0; p < producers; ++p)
+            workers.emplace_back([&, p]
+            {
+                for (long i = p; i < OPS; i += producers)
+                    q.push(i);
+            });
+        for (int c = 0; c < consumers; ++c)
+            workers.emplace_back([&, c]
+            {
+                long share = OPS / consumers + (c < OPS % consumers ? 1 : 0);
+                long v, sum = 0;
+                for (long i = 0; i < share; ++i, sum += v)
+                    q.pop(v);
+                sums[c] = sum;
+            });
+        for (auto& w : workers)
+            w.join();
+    }
+    double ms = t.ms();
+    long total = 0;
+    for (long s : sums)
+        total += s;
+    ok = ok && total == OPS * (OPS - 1) / 2;
+    return ms;
+}
+
+int main()
+{
+    cout << "**** tmpmc_queue Contention Benchmark ****" << endl;
+    cout << "  threads   tmpmc_queue(Mops/s)   mutex+std::queue(Mops/s)" << endl;
+    bool ok = true;
+    for (int threads = 1; threads <= 64; threads *= 2)
+    {
+        tmpmc_queue<long> mq(CAPACITY);
+        LockedQueue lq;
+        double mms = Run(mq, threads, ok);
+        double lms = Run(lq, threads, ok);
+        cout << "  " << threads << "\t    " << OPS / mms / 1000 << "\t\t  " << OPS / lms / 1000 << endl;
+    }
+    cout << "  sums " << (ok ? "ok" : "WRONG") << endl;
+    cout << "******************************************" << endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,99 @@
+/*
+    Project:        toympmc_queue_test
+    Update date:    2026/10/17
+    Author:         Zhuofan Zhang
+*/
+#include"toympmc_queue.hpp"
+#include<atomic>
+#include<string>
+#include<thread>
+#include<vector>
+using toy_std::tmpmc_queue;
+using std::cout;
+using std::endl;
+
+void SingleThread()
+{
+    cout << "**** Single Thread Check ****" << endl;
+    tmpmc_queue<std::string> Queue(3);
+    cout << "capacity(3 rounds up to 4): " << Queue.capacity() << endl;
+
+    std::string out = "untouched";
+    cout << "try_pop on empty: " << Queue.try_pop(out) << ", out: " << out << endl;
+
+    const char* words[] = { "a", "b", "c", "d", "e" };
+    for (int i = 0; i < 5; ++i)
+        cout << "try_push(" << words[i] << "): " << Queue.try_push(words[i]) << endl;
+    cout << "size when full: " << Queue.size() << endl;
+
+    // A failed try_push(T&&) leaves its argument alone.
+    std::string keep(32, 'k');
+    cout << "try_push(move) on full: " << Queue.try_push(std::move(keep))
+         << ", argument kept: " << (keep.size() == 32) << endl;
+
+    Queue.try_pop(out);
+    cout << "try_pop: " << out << ", try_emplace(3, 'f'): " << Queue.try_emplace(3, 'f') << endl;
+
+    // Leave elements behind: the destructor frees them.
+    cout << "FIFO: ";
+    while (Queue.size() > 1 && Queue.try_pop(out))
+        cout << out << ' ';
+    cout << endl << "*****************************" << endl;
+}
+
+/*
+    Every producer pushes its own range of values; the consumers mark
+    what they take. Each value has to be seen exactly once.
+*/
+void ManyThreads()
+{
+    cout << "**** Producers/Consumers Check ****" << endl;
+    const int PRODUCERS = 4;
+    const int CONSUMERS = 4;
+    const long PER_PRODUCER = 250000;
+    const long N = PRODUCERS * PER_PRODUCER;
+    tmpmc_queue<long> Queue(256);
+    std::vector<std::atomic<int>> seen(N);
+    for (auto& s : seen)
+        s.store(0, std::memory_order_relaxed);
+    std::atomic<long> taken(0);
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < PRODUCERS; ++p)
+        threads.emplace_back([&Queue, p, PER_PRODUCER]()
+        {
+            for (long i = 0; i < PER_PRODUCER; ++i)
+                Queue.push(p * PER_PRODUCER + i);
+        });
+    for (int c = 0; c < CONSUMERS; ++c)
+        threads.emplace_back([&Queue, &seen, &taken, N]()
+        {
+            long v;
+            while (taken.load(std::memory_order_relaxed) < N)
+            {
+                if (!Queue.try_pop(v))
+                    continue;
+                seen[v].fetch_add(1, std::memory_order_relaxed);
+                taken.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    for (auto& t : threads)
+        t.join();
+
+    long missing = 0, duplicated = 0;
+    for (auto& s : seen)
+    {
+        int n = s.load(std::memory_order_relaxed);
+        missing += n == 0;
+        duplicated += n > 1;
+    }
+    cout << "received: " << taken.load() << " of " << N << ", missing: " << missing
+         << ", duplicated: " << duplicated << ", empty: " << Queue.empty() << endl;
+    cout << "***********************************" << endl;
+}
+
+int main()
+{
+    SingleThread();
+    ManyThreads();
+}
@@ -0,0 +1,208 @@
+/*
+    Project:        toysmall_vector_test
+    Update date:    2026/10/17
+    Author:         Zhuofan Zhang
+*/
+#include"toysmall_vector.hpp"
+#include<string>
+using toy_std::tsmall_vector;
+using std::cout;
+using std::endl;
+
+// 4 elements inline: every check below crosses the inline/heap boundary.
+template<typename T>
+using small_vec = tsmall_vector<T, 4>;
+
+template<typename Vec>
+void Print(const char* name, const Vec& v)
+{
+    cout << name;
+    for (auto it = v.begin(); it != v.end(); ++it)
+        cout << *it << ' ';
+    cout << "(size " << v.size() << ", " << (v.is_inline() ? "inline" : "heap") << ')' << endl;
+}
+
+// Copies throw once 'Countdown' reaches zero.
+int Countdown = -1;
+
+struct Fragile
+{
+    int v;
+    Fragile(int x) : v(x) { }
+    Fragile(const Fragile& o) : v(o.v)
+    {
+        if (Countdown >= 0 && Countdown-- == 0)
+            throw 1;
+    }
+    Fragile& operator=(const Fragile&) = default;
+};
+
+// Tagged allocator that travels on copy, move and swap.
+template<typename T>
+struct PropagatingAllocator : toy_std::tallocator<T>
+{
+    int id;
+    PropagatingAllocator(int i = 0) : id(i) { }
+};
+
+template<typename T>
+bool operator==(const PropagatingAllocator<T>& a, const PropagatingAllocator<T>& b) { return a.id == b.id; }
+template<typename T>
+bool operator!=(const PropagatingAllocator<T>& a, const PropagatingAllocator<T>& b) { return a.id != b.id; }
+
+namespace toy_std
+{
+    template<typename T>
+    struct tallocator_traits<PropagatingAllocator<T>> : __tallocator_traits_base<PropagatingAllocator<T>>
+    {
+        using propagate_on_container_copy_assignment = __true_type;
+        using propagate_on_container_move_assignment = __true_type;
+        using propagate_on_container_swap = __true_type;
+    };
+}
+
+void ConstructorTest()
+{
+    cout << "**** Constructors Check ****" << endl;
+    small_vec<int> Default;
+    small_vec<int> InitList({ 1,2,3 });
+    small_vec<int> SameValue(6, 1);
+    small_vec<int> Copy(SameValue);
+    Print("Default: ", Default);
+    Print("InitList: ", InitList);
+    Print("SameValue: ", SameValue);
+    Print("Copy: ", Copy);
+    cout << "****************************" << endl;
+}
+
+void Capacity()
+{
+    cout << "**** Capacity Check ****" << endl;
+    small_vec<std::string> TestVec;
+    for (int i = 0; i < 4; ++i)
+        TestVec.emplace_back(1, char('a' + i));
+    Print("Full inline: ", TestVec);
+
+    /* spill to the heap */
+    TestVec.push_back("e");
+    Print("Spilled: ", TestVec);
+
+    /* shrink back inline once the elements fit */
+    TestVec.pop_back();
+    TestVec.pop_back();
+    TestVec.shrink_to_fit();
+    Print("Shrink to fit: ", TestVec);
+    cout << "Capacity(should be 4): " << TestVec.capacity() << endl;
+
+    /* one-at-a-time growth past N stays geometric */
+    small_vec<int> Grow;
+    size_t reallocations = 0, cap = Grow.capacity();
+    for (int i = 0; i < 1000; ++i)
+    {
+        Grow.insert(Grow.end(), 1, i);
+        if (Grow.capacity() != cap)
+        {
+            cap = Grow.capacity();
+            ++reallocations;
+        }
+    }
+    cout << "Reallocations for 1000 insert(end, 1, x): " << reallocations << endl;
+    cout << "************************" << endl;
+}
+
+void Modifiers()
+{
+    cout << "**** Modifers Check ****" << endl;
+    small_vec<std::string> TestVec = { "a", "b", "c" };
+
+    /* insert/erase in the middle, inline and on the heap */
+    TestVec.insert(TestVec.begin() + 1, "x");
+    Print("Insert inline: ", TestVec);
+    auto _oit = TestVec.insert(TestVec.begin() + 2, { "y", "z" });
+    Print("Insert spills: ", TestVec);
+    cout << "pos check: " << *_oit << endl;
+    TestVec.insert(TestVec.begin() + 1, 2, TestVec.back());
+    Print("Insert own back: ", TestVec);
+    TestVec.erase(TestVec.begin() + 1, TestVec.begin() + 4);
+    Print("Erase [1,4): ", TestVec);
+
+    /* a throwing copy leaves the contents as they were */
+    small_vec<Fragile> Frag = { 1, 2, 3 };
+    Countdown = 2;
+    try
+    {
+        Frag.insert(Frag.begin() + 1, 5, Fragile(9));
+    }
+    catch (int)
+    {
+        cout << "insert threw, contents: ";
+        for (auto it = Frag.begin(); it != Frag.end(); ++it)
+            cout << it->v << ' ';
+        cout << endl;
+    }
+    Countdown = -1;
+    cout << "************************" << endl;
+}
+
+void MoveAndSwap()
+{
+    cout << "**** Move/Swap Check ****" << endl;
+    small_vec<std::string> Inline = { "a", "b" };
+    small_vec<std::string> Heap = { "1", "2", "3", "4", "5", "6" };
+
+    small_vec<std::string> MovedInline(std::move(Inline));
+    small_vec<std::string> MovedHeap(std::move(Heap));
+    Print("Moved inline: ", MovedInline);
+    Print("Moved heap: ", MovedHeap);
+    cout << "Moved-from sizes(should be 0 0): " << Inline.size() << ' ' << Heap.size() << endl;
+
+    MovedInline.swap(MovedHeap);
+    Print("Swapped(was inline): ", MovedInline);
+    Print("Swapped(was heap): ", MovedHeap);
+
+    Inline = std::move(MovedInline);
+    Print("Move-assigned: ", Inline);
+    cout << "*************************" << endl;
+}
+
+void AllocatorPropagation()
+{
+    cout << "**** Allocator Propagation Check ****" << endl;
+    using alloc = PropagatingAllocator<std::string>;
+    using prop_vec = tsmall_vector<std::string, 4, alloc>;
+    prop_vec A(alloc(1)), B(alloc(2)), C(alloc(3));
+    for (int i = 0; i < 6; ++i)
+        A.push_back(std::string(1, char('a' + i)));
+    B.push_back("x");
+    C = { "1", "2", "3", "4", "5" };
+
+    /* move: the heap buffer and the allocator both change hands */
+    const std::string* storage = A.data();
+    B = std::move(A);
+    cout << "Move-assigned: storage stolen, allocator taken(should be 1 1): "
+         << (B.data() == storage) << ' ' << (B.get_allocator().id == 1) << endl;
+
+    /* copy: the allocator follows */
+    A = C;
+    Print("Copy-assigned: ", A);
+    cout << "Allocator taken(should be 3): " << A.get_allocator().id << endl;
+
+    /* swap: heap buffers and allocators trade places */
+    const std::string* b_storage = B.data();
+    const std::string* c_storage = C.data();
+    B.swap(C);
+    cout << "Swapped: storage and allocators traded(should be 1 1 3 1): " << (B.data() == c_storage)
+         << ' ' << (C.data() == b_storage) << ' ' << B.get_allocator().id << ' ' << C.get_allocator().id << endl;
+    Print("B: ", B);
+    Print("C: ", C);
+    cout << "*************************************" << endl;
+}
+
+int main()
+{
+    ConstructorTest();
+    Capacity();
+    Modifiers();
+    MoveAndSwap();
+    AllocatorPropagation();
+}
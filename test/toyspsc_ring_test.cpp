@@ -0,0 +1,77 @@
+/*
+    Project:        toyspsc_ring_test
+    Update date:    2026/10/17
+    Author:         Zhuofan Zhang
+*/
+#include"toyspsc_ring.hpp"
+#include<string>
+#include<thread>
+#include<vector>
+using toy_std::tspsc_ring;
+using std::cout;
+using std::endl;
+
+void SingleThread()
+{
+    cout << "**** Single Thread Check ****" << endl;
+    tspsc_ring<std::string, 4> Ring;
+    const char* words[] = { "a", "b", "c", "d", "e" };
+    for (int i = 0; i < 5; ++i)
+        cout << "try_push(" << words[i] << "): " << Ring.try_push(words[i]) << endl;
+
+    std::string out;
+    Ring.try_pop(out);
+    cout << "try_pop: " << out << ", size: " << Ring.size() << endl;
+
+    // Wraps around the end of the buffer.
+    std::string more[] = { "x", "y", "z" };
+    cout << "push_batch(3): " << Ring.push_batch(more, 3) << endl;
+    std::vector<std::string> all;
+    cout << "pop_batch(8): " << Ring.pop_batch(std::back_inserter(all), 8) << " -> ";
+    for (auto& s : all)
+        cout << s << ' ';
+    cout << endl << "empty: " << Ring.empty() << endl;
+    cout << "*****************************" << endl;
+}
+
+void TwoThreads()
+{
+    cout << "**** Producer/Consumer Check ****" << endl;
+    const long N = 1000000;
+    tspsc_ring<long, 1024> Ring;
+
+    std::thread producer([&]
+    {
+        long batch[16];
+        long next = 0;
+        while (next < N)
+        {
+            long n = 0;
+            for (; n < 16 && next + n < N; ++n)
+                batch[n] = next + n;
+            next += Ring.push_batch(batch, size_t(n));
+        }
+    });
+
+    long expected = 0, sum = 0;
+    bool ordered = true;
+    while (expected < N)
+    {
+        long v;
+        if (!Ring.try_pop(v))
+            continue;
+        ordered = ordered && v == expected;
+        sum += v;
+        ++expected;
+    }
+    producer.join();
+    cout << "received: " << expected << ", in order: " << ordered
+         << ", sum ok: " << (sum == N * (N - 1) / 2) << endl;
+    cout << "*********************************" << endl;
+}
+
+int main()
+{
+    SingleThread();
+    TwoThreads();
+}
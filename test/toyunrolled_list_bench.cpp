@@ -0,0 +1,87 @@
+/*
+    Project:        toyunrolled_list_bench
+    Update date:    2026/10/17
+    Author:         Zhuofan Zhang
+
+    Sequential scans(sum of every element) of a tunrolled_list<int>
+    against tlist<int> and std::list<int>, for a list built by push_back
+    and one built by inserting in the middle(nodes scattered in memory),
+    plus the cost of those middle insertions.
+*/
+#include"toyunrolled_list.hpp"
+#include"toylist.hpp"
+#include<list>
+#include<chrono>
+using toy_std::tunrolled_list;
+using toy_std::tlist;
+using std::cout;
+using std::endl;
+
+const int N = 1 << 20;
+const int SCANS = 50;
+
+struct Timer
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    double ms() const
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+};
+
+template<typename List>
+double Scan(List& l, long& sum)
+{
+    long local = 0;
+    Timer t;
+    for (int s = 0; s < SCANS; ++s)
+        for (auto it = l.begin(); it != l.end(); ++it)
+            local += *it;
+    double ms = t.ms() / SCANS;
+    sum += local;
+    return ms;
+}
+
+// Every new element goes just before the middle iterator, which is walked forward now and then.
+template<typename List>
+double BuildMiddle(List& l)
+{
+    Timer t;
+    l.push_back(int(0));
+    auto mid = l.begin();
+    for (int i = 1; i < N; ++i)
+    {
+        mid = l.insert(mid, int(i));
+        if (i % 2 == 0)
+            ++mid;
+    }
+    return t.ms();
+}
+
+template<typename List>
+void Run(const char* name)
+{
+    long sum = 0;
+    List seq;
+    for (int i = 0; i < N; ++i)
+        seq.push_back(int(i));
+    double s1 = Scan(seq, sum);
+
+    List mid;
+    double build = BuildMiddle(mid);
+    double s2 = Scan(mid, sum);
+
+    cout << "  " << name << ":\tscan " << s1 << " ms,\tscan(middle-built) " << s2
+         << " ms,\tmiddle inserts " << build << " ms\t(" << (sum & 1) << ")" << endl;
+}
+
+int main()
+{
+    cout << "**** tunrolled_list Benchmark(" << N << " ints, node capacity "
+         << tunrolled_list<int>::node_capacity() << ") ****" << endl;
+    Run<tunrolled_list<int>>("tunrolled_list");
+    Run<tlist<int>>("tlist");
+    Run<std::list<int>>("std::list");
+    cout << "****************************************************" << endl;
+    return 0;
+}
@@ -0,0 +1,172 @@
+/*
+    Project:        toyunrolled_list_test
+    Update date:    2026/10/17
+    Author:         Zhuofan Zhang
+*/
+#include"toyunrolled_list.hpp"
+#include<string>
+using toy_std::tunrolled_list;
+using std::cout;
+using std::endl;
+
+// 4 elements per node: every check below crosses node boundaries.
+template<typename T>
+using small_list = tunrolled_list<T, 4>;
+
+// Move assignment throws once 'Countdown' reaches zero; counts live objects.
+int Countdown = -1;
+int Live = 0;
+
+struct Fragile
+{
+    int v;
+    Fragile(int x) : v(x) { ++Live; }
+    Fragile(const Fragile& o) : v(o.v) { ++Live; }
+    Fragile(Fragile&& o) noexcept : v(o.v) { ++Live; }
+    Fragile& operator=(const Fragile& o) { v = o.v; return *this; }
+    Fragile& operator=(Fragile&& o)
+    {
+        if (Countdown >= 0 && Countdown-- == 0)
+            throw 1;
+        v = o.v;
+        return *this;
+    }
+    ~Fragile() { --Live; }
+};
+
+template<typename List>
+void Print(const char* name, const List& l)
+{
+    cout << name;
+    for (auto it = l.begin(); it != l.end(); ++it)
+        cout << *it << ' ';
+    cout << endl;
+}
+
+void ConstructorTest()
+{
+    cout << "**** Constructors Check ****" << endl;
+    small_list<int> Default;
+    small_list<int> InitList({ 1,2,3,4,5,6,7,8,9 });
+    small_list<int> SameValue(5, 1);
+    small_list<int> Copy(InitList);
+    small_list<int> Move(std::move(Copy));
+    cout << "Default Size: " << Default.size() << endl;
+    Print("InitList: ", InitList);
+    Print("SameValue: ", SameValue);
+    Print("Move: ", Move);
+    cout << "Moved-from Size(should be 0): " << Copy.size() << endl;
+    cout << "****************************" << endl;
+}
+
+void Iterators()
+{
+    cout << "**** Iterators Check ****" << endl;
+    small_list<char> TestList = { 'H','e','l','l','o',',','w','o','r','l','d' };
+    Print("TestList: ", TestList);
+    cout << "Reverse TestList: ";
+    for (auto rit = TestList.rbegin(); rit != TestList.rend(); ++rit)
+        cout << *rit << ' ';
+    cout << endl;
+    cout << "*************************" << endl;
+}
+
+void Modifiers()
+{
+    cout << "**** Modifers Check ****" << endl;
+    small_list<std::string> TestList = { "a", "b", "c", "d" };
+
+    /* insert into a full node: it splits */
+    auto _oit = TestList.insert(++TestList.begin(), { "x", "y" });
+    Print("Insert: ", TestList);
+    cout << "pos check: " << *_oit << endl;
+
+    /* push_back/front */
+    TestList.push_front("front");
+    TestList.emplace_back(3, 'z');
+    Print("Push: ", TestList);
+
+    /* erase */
+    auto first = TestList.begin();
+    ++first;
+    auto last = first;
+    ++last;
+    ++last;
+    TestList.erase(first, last);
+    Print("Erase [1,3): ", TestList);
+    TestList.pop_front();
+    TestList.pop_back();
+    Print("Pop: ", TestList);
+
+    /* insert an element of the list itself into a full node */
+    small_list<std::string> Full = { "aaa", "bbb", "ccc", std::string(32, 'd') };
+    Full.insert(++Full.begin(), Full.back());
+    Print("Insert own back: ", Full);
+    cout << "************************" << endl;
+}
+
+void Operations()
+{
+    cout << "**** Operations Check ****" << endl;
+    small_list<int> A = { 3,7,5,9,1,5,5,8,2 };
+    A.sort();
+    Print("Sort: ", A);
+    A.unique();
+    Print("Unique: ", A);
+    A.remove(8);
+    Print("Remove 8: ", A);
+    A.reverse();
+    Print("Reverse: ", A);
+    cout << "**************************" << endl;
+}
+
+void AllocatorTest()
+{
+    cout << "**** Allocator Check ****" << endl;
+    using arena_list = tunrolled_list<int, 4, toy_std::tarena_allocator<int>>;
+    toy_std::tmonotonic_arena First, Second;
+    arena_list A({ 5,3,9,1,7,2 }, toy_std::tarena_allocator<int>(First));
+    arena_list B({ 8 }, toy_std::tarena_allocator<int>(Second));
+
+    /* sort buffers through the list's own allocator */
+    A.sort();
+    Print("Sorted on the arena: ", A);
+
+    /* the arena propagates: B takes A's nodes and A's arena */
+    const int* first = &A.front();
+    B = std::move(A);
+    cout << "Move-assigned: nodes stolen, arena taken(should be 1 1): " << (&B.front() == first)
+         << ' ' << (B.get_allocator().arena() == &First) << endl;
+    cout << "*************************" << endl;
+}
+
+void ExceptionSafety()
+{
+    cout << "**** Exception Safety Check ****" << endl;
+    {
+        small_list<Fragile> TestList = { 1, 2, 3 };
+        Countdown = 0;
+        try
+        {
+            TestList.insert(TestList.begin(), Fragile(0));
+        }
+        catch (int)
+        {
+            cout << "insert threw, size: " << TestList.size();
+        }
+        Countdown = -1;
+        cout << ", live(should be 3): " << Live << endl;
+    }
+    cout << "Live after destruction(should be 0): " << Live << endl;
+    cout << "********************************" << endl;
+}
+
+int main()
+{
+    ConstructorTest();
+    Iterators();
+    Modifiers();
+    Operations();
+    AllocatorTest();
+    ExceptionSafety();
+}
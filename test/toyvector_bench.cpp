@@ -0,0 +1,84 @@
+/*
+    Project:        toyvector_bench
+    Update date:    2026/10/17
+    Author:         Zhuofan Zhang
+
+    tvector against std::vector:
+        push_back     -- N appends from empty(growth + relocation)
+        reserve       -- repeated reserve() doubling a full vector(pure relocation)
+    for a POD type(memcpy relocation) and std::string(move relocation).
+*/
+#include"toyvector.hpp"
+#include<vector>
+#include<string>
+#include<chrono>
+using toy_std::tvector;
+using std::cout;
+using std::endl;
+
+const int N = 1 << 20;
+const int REPEAT = 20;
+
+struct Timer
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    double ms() const
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+};
+
+template<typename T> T MakeValue(int i) { return T(i); }
+template<> std::string MakeValue<std::string>(int i) { return std::string(24, char('a' + i % 26)); }
+
+template<typename Vector>
+double PushBack()
+{
+    using T = typename Vector::value_type;
+    T value = MakeValue<T>(7);
+    Timer t;
+    for (int r = 0; r < REPEAT; ++r)
+    {
+        Vector v;
+        for (int i = 0; i < N; ++i)
+            v.push_back(value);
+    }
+    return t.ms();
+}
+
+template<typename Vector>
+double Reallocate()
+{
+    using T = typename Vector::value_type;
+    Vector v(N / 16, MakeValue<T>(7));
+    Timer t;
+    for (int r = 0; r < REPEAT; ++r)
+    {
+        Vector w(v);
+        for (size_t cap = w.size() * 2; cap <= size_t(N); cap *= 2)
+            w.reserve(cap);
+    }
+    return t.ms();
+}
+
+template<typename T>
+void Compare(const char* name)
+{
+    double tp = PushBack<tvector<T>>(), sp = PushBack<std::vector<T>>();
+    double tr = Reallocate<tvector<T>>(), sr = Reallocate<std::vector<T>>();
+    cout << name << endl;
+    cout << "  push_back x" << N << ":  tvector " << tp / REPEAT << " ms, std::vector "
+         << sp / REPEAT << " ms" << endl;
+    cout << "  reserve doubling:     tvector " << tr / REPEAT << " ms, std::vector "
+         << sr / REPEAT << " ms" << endl;
+}
+
+int main()
+{
+    cout << "**** tvector Benchmark ****" << endl;
+    Compare<int>("int(POD: memcpy relocation)");
+    Compare<double>("double(POD: memcpy relocation)");
+    Compare<std::string>("std::string(move relocation)");
+    cout << "***************************" << endl;
+    return 0;
+}
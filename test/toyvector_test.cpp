@@ -0,0 +1,244 @@
+/*
+    Project:        toyvector_test
+    Update date:    2026/10/17
+    Author:         Zhuofan Zhang
+*/
+#include"toyvector.hpp"
+#include<string>
+using toy_std::tvector;
+using std::cout;
+using std::endl;
+
+template<typename Vec>
+void Print(const char* name, const Vec& v)
+{
+    cout << name;
+    for (auto it = v.begin(); it != v.end(); ++it)
+        cout << *it << ' ';
+    cout << "(size " << v.size() << ')' << endl;
+}
+
+/*
+    Knows its own address: a relocation that memcpy'd it instead of
+    moving it leaves 'self' pointing at the old storage.
+*/
+int Live = 0;
+int Copies = 0;
+
+struct Tracked
+{
+    int v;
+    Tracked* self;
+    Tracked(int x) : v(x), self(this) { ++Live; }
+    Tracked(const Tracked& o) : v(o.v), self(this) { ++Live; ++Copies; }
+    Tracked(Tracked&& o) noexcept : v(o.v), self(this) { o.v = -1; ++Live; }
+    Tracked& operator=(const Tracked& o) { v = o.v; return *this; }
+    Tracked& operator=(Tracked&& o) noexcept { v = o.v; o.v = -1; return *this; }
+    ~Tracked() { --Live; }
+    bool intact() const { return self == this; }
+};
+
+// Move may throw: reallocation has to copy to stay strongly exception-safe.
+int Countdown = -1;
+int Moves = 0;
+
+struct Fragile
+{
+    int v;
+    Fragile(int x) : v(x) { }
+    Fragile(const Fragile& o) : v(o.v)
+    {
+        if (Countdown >= 0 && Countdown-- == 0)
+            throw 1;
+    }
+    Fragile(Fragile&& o) : v(o.v) { ++Moves; }      // never called on reallocation
+    Fragile& operator=(const Fragile&) = default;
+};
+
+// Copies and moves both throw once 'Countdown' reaches zero; counts live objects.
+struct Bomb
+{
+    int v;
+    Bomb(int x) : v(x) { ++Live; }
+    Bomb(const Bomb& o) : v(o.v) { tick(); ++Live; }
+    Bomb(Bomb&& o) : v(o.v) { tick(); ++Live; }
+    Bomb& operator=(const Bomb& o) { tick(); v = o.v; return *this; }
+    Bomb& operator=(Bomb&& o) { tick(); v = o.v; return *this; }
+    ~Bomb() { --Live; }
+    static void tick()
+    {
+        if (Countdown >= 0 && Countdown-- == 0)
+            throw 1;
+    }
+};
+
+// Distinct ids never compare equal, so storage can't change hands.
+template<typename T>
+struct TaggedAllocator : toy_std::tallocator<T>
+{
+    int id;
+    TaggedAllocator(int i = 0) : id(i) { }
+};
+
+template<typename T>
+bool operator==(const TaggedAllocator<T>& a, const TaggedAllocator<T>& b) { return a.id == b.id; }
+template<typename T>
+bool operator!=(const TaggedAllocator<T>& a, const TaggedAllocator<T>& b) { return a.id != b.id; }
+
+void ConstructorTest()
+{
+    cout << "**** Constructors Check ****" << endl;
+    tvector<int> Default;
+    tvector<int> InitList({ 1,2,3 });
+    tvector<int> SameValue(5, 1);
+    tvector<std::string> Copy(3, "ab");
+    tvector<std::string> FromOther(Copy.begin(), Copy.end());
+    Print("Default: ", Default);
+    Print("InitList: ", InitList);
+    Print("SameValue: ", SameValue);
+    Print("Copy: ", Copy);
+    Print("FromOther: ", FromOther);
+    cout << "****************************" << endl;
+}
+
+void Relocation()
+{
+    cout << "**** Relocation Check ****" << endl;
+    {
+        tvector<Tracked> TestVec;
+        for (int i = 0; i < 1000; ++i)
+            TestVec.emplace_back(i);
+        TestVec.reserve(5000);
+        TestVec.insert(TestVec.begin() + 10, Tracked(-7));
+        TestVec.shrink_to_fit();
+
+        bool intact = true;
+        for (const Tracked& t : TestVec)
+            intact &= t.intact();
+        cout << "Non-trivial relocation(should be 1 1001 0): " << intact << ' '
+             << Live << ' ' << Copies << endl;
+    }
+    cout << "Live after destruction(should be 0): " << Live << endl;
+
+    /* a copy throwing in the middle of a reallocation leaves the vector as it was */
+    tvector<Fragile> Frag;
+    for (int i = 0; i < 4; ++i)
+        Frag.push_back(Fragile(i));
+    Frag.shrink_to_fit();
+    Fragile Nine(9);
+    Moves = 0;
+    Countdown = 2;
+    try
+    {
+        Frag.push_back(Nine);
+    }
+    catch (int)
+    {
+        cout << "push_back threw, contents: ";
+        for (const Fragile& f : Frag)
+            cout << f.v << ' ';
+        cout << "(moves " << Moves << ')' << endl;
+    }
+    Countdown = -1;
+    cout << "**************************" << endl;
+}
+
+void AliasedInsert()
+{
+    cout << "**** Aliased Insert Check ****" << endl;
+    tvector<std::string> TestVec = { "a", "b", "c" };
+    TestVec.shrink_to_fit();
+
+    /* no spare capacity: the value lives in the storage being replaced */
+    TestVec.push_back(TestVec[0]);
+    Print("push_back(v[0]) full: ", TestVec);
+    TestVec.shrink_to_fit();
+    TestVec.insert(TestVec.begin(), TestVec.back());
+    Print("insert(begin, back) full: ", TestVec);
+
+    /* spare capacity: the value lives in the part being shifted */
+    TestVec.reserve(32);
+    TestVec.insert(TestVec.begin(), TestVec[2]);
+    Print("insert(begin, v[2]): ", TestVec);
+    TestVec.insert(TestVec.begin() + 1, 3, TestVec.back());
+    Print("insert(begin+1, 3, back): ", TestVec);
+    TestVec.emplace(TestVec.begin(), TestVec[4]);
+    Print("emplace(begin, v[4]): ", TestVec);
+    cout << "******************************" << endl;
+}
+
+/*
+    Inserting in the middle with spare capacity: whichever copy or move
+    throws, every live object is inside [begin, end) afterwards.
+*/
+void InsertExceptionSafety()
+{
+    cout << "**** Insert Exception Check ****" << endl;
+    int consistent = 0, thrown = 0;
+    for (int run = 0; run < 36; ++run)
+    {
+        int op = run / 12, at = run % 12;
+        Live = 0;
+        {
+            tvector<Bomb> TestVec;
+            TestVec.reserve(16);
+            for (int i = 0; i < 6; ++i)
+                TestVec.emplace_back(i);
+            Bomb Value(9);
+            Bomb Range[] = { 7, 8 };
+            Countdown = at;
+            try
+            {
+                if (op == 0)
+                    TestVec.insert(TestVec.begin() + 2, 3, Value);
+                else if (op == 1)
+                    TestVec.insert(TestVec.begin() + 4, Range, Range + 2);
+                else
+                    TestVec.insert(TestVec.begin() + 1, Value);
+            }
+            catch (int)
+            {
+                ++thrown;
+            }
+            Countdown = -1;
+            consistent += Live == int(TestVec.size()) + 3;
+        }
+        consistent += Live == 0 ? 0 : -100;
+    }
+    cout << "Throw points: " << thrown << ", consistent(should be 36): " << consistent << endl;
+    cout << "********************************" << endl;
+}
+
+void MoveAssign()
+{
+    cout << "**** Move Assign Check ****" << endl;
+    using tagged_vector = tvector<std::string, TaggedAllocator<std::string>>;
+
+    /* equal allocators: the storage changes hands */
+    tagged_vector A(TaggedAllocator<std::string>(1));
+    tagged_vector B(TaggedAllocator<std::string>(1));
+    A.push_back(std::string(32, 'x'));
+    const std::string* storage = A.data();
+    B = std::move(A);
+    cout << "Equal allocators, storage stolen(should be 1): " << (B.data() == storage) << endl;
+
+    /* unequal allocators: the elements move one by one into B's storage */
+    tagged_vector C(TaggedAllocator<std::string>(2));
+    C.push_back(std::string(32, 'y'));
+    C.push_back("z");
+    storage = C.data();
+    B = std::move(C);
+    Print("Unequal allocators: ", B);
+    cout << "Own storage, own allocator, source empty(should be 1 1 1): "
+         << (B.data() != storage) << ' ' << (B.get_allocator().id == 1) << ' ' << C.empty() << endl;
+    cout << "***************************" << endl;
+}
+
+int main()
+{
+    ConstructorTest();
+    Relocation();
+    AliasedInsert();
+    InsertExceptionSafety();
+    MoveAssign();
+}